@@ -1,11 +1,23 @@
 #include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <random>
+#include <string>
 
 #include "../src/TrafficManager/traffic_manager.h"
 #include "../src/Graphs/Graph/graph.h"
+#include "../src/Graphs/Tree/tree.h"
+#include "../src/Graphs/Ring/ring.h"
+#include "../src/Graphs/Grid/grid.h"
 #include "../src/Graphs/Clique/clique.h"
 #include "../src/Graphs/Chain/chain.h"
+#include "../src/Graphs/Composite/composite.h"
+#include "graph_generators.h"
+#include "suite_benchmarks.h"
+
+// every run generates the same graphs and orders
+const uint64_t kSeed = 20220314;
 
 class RandomGenerator {
  public:
@@ -16,7 +28,7 @@ class RandomGenerator {
   std::vector<int> GetVector(int size);
 
  private:
-  std::mt19937 gen{std::random_device()()};
+  std::mt19937 gen{kSeed};
   std::uniform_int_distribution<int64_t> distribution;
 };
 
@@ -36,36 +48,108 @@ std::vector<int> RandomGenerator::GetVector(int size) {
   return result;
 }
 
-template<typename GraphClass>
+struct Order {
+  int from{0};
+  int to{0};
+  int buns_amount{0};
+};
+
+// makes 'attempts_count' random orders and keeps ones, which can be completed
+// with vehicles from 'from' town, when orders are executed one after another
+template<typename Manager>
+static std::vector<Order> GenerateOrders(Manager traffic_manager,
+                                         int vehicle_capacity,
+                                         int attempts_count,
+                                         RandomGenerator* gen) {
+  std::vector<Order> orders;
+  for (int i = 0; i < attempts_count; ++i) {
+    int from = gen->GetValue();
+    int to = gen->GetValue();
+    int buns_to_transport = gen->GetValue();
+    int from_buns_amount = traffic_manager.GetBunsAmount(from);
+    int from_vehicles = traffic_manager.GetVehicle(from);
+    int max_possible = std::min(from_buns_amount,
+                                from_vehicles * vehicle_capacity);
+    if (buns_to_transport <= max_possible) {
+      traffic_manager.Transport(from, to, buns_to_transport);
+      orders.push_back({from, to, buns_to_transport});
+    }
+  }
+  return orders;
+}
+
+// replays orders once more, measuring every Transport separately
+template<typename Manager>
+static void SetLatencyCounters(benchmark::State& state,
+                               Manager traffic_manager,
+                               const std::vector<Order>& orders) {
+  if (orders.empty()) {
+    return;
+  }
+  std::vector<int64_t> latencies;
+  latencies.reserve(orders.size());
+  for (const auto& order : orders) {
+    auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(traffic_manager.Transport(order.from,
+                                                       order.to,
+                                                       order.buns_amount));
+    auto finish = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        finish - start).count());
+  }
+  std::sort(latencies.begin(), latencies.end());
+  for (int percentile : {50, 90, 99}) {
+    state.counters["p" + std::to_string(percentile) + "_ns"] =
+        latencies[(latencies.size() - 1) * percentile / 100];
+  }
+}
+
+// Orders are generated before timing and replayed from the same initial state
+// on every iteration.
+// Manager is TrafficManager for virtual calls or
+// BasicTrafficManager<GraphClass> for calls resolved at compile time
+template<typename GraphClass, typename Manager = TrafficManager>
 static void BM_Transport(benchmark::State& state) {
+  int graph_size = state.range(0);
+  RandomGenerator gen(0, graph_size - 1);
+  GraphClass graph(graph_size);
+  std::vector<int> buns_amounts = gen.GetVector(graph_size);
+  std::vector<int> vehicles = gen.GetVector(graph_size);
+  int vehicle_capacity = gen.GetValue() + 1;
+  const Manager initial_traffic_manager(&graph,
+                                        buns_amounts,
+                                        vehicles,
+                                        vehicle_capacity);
+  std::vector<Order> orders = GenerateOrders(initial_traffic_manager,
+                                             vehicle_capacity,
+                                             state.range(1),
+                                             &gen);
+
   for (auto _ : state) {
     state.PauseTiming();
-    int graph_size = state.range(0);
-    RandomGenerator gen(0, graph_size - 1);
-    GraphClass graph(graph_size);
-    std::vector<int> buns_amounts = gen.GetVector(graph_size);
-    std::vector<int> vehicles = gen.GetVector(graph_size);
-    int vehicle_capacity = gen.GetValue() + 1;
-    TrafficManager traffic_manager(&graph,
-                                   buns_amounts,
-                                   vehicles,
-                                   vehicle_capacity);
-    int64_t iters_count = state.range(1);
-    for (int i = 0; i < iters_count; ++i) {
-      int from = gen.GetValue();
-      int to = gen.GetValue();
-      int buns_to_transport = gen.GetValue();
-      int from_buns_amount = traffic_manager.GetBunsAmount(from);
-      int from_vehicles = traffic_manager.GetVehicle(from);
-      int max_possible = std::min(from_buns_amount,
-                                  from_vehicles * vehicle_capacity);
-      if (buns_to_transport <= max_possible) {
-        state.ResumeTiming();
-        traffic_manager.Transport(from, to, buns_to_transport);
-        state.PauseTiming();
-      }
+    Manager traffic_manager = initial_traffic_manager;
+    state.ResumeTiming();
+    for (const auto& order : orders) {
+      benchmark::DoNotOptimize(traffic_manager.Transport(order.from,
+                                                         order.to,
+                                                         order.buns_amount));
     }
   }
+
+  state.SetItemsProcessed(state.iterations() * orders.size());
+  state.counters["orders"] = orders.size();
+  SetLatencyCounters(state, initial_traffic_manager, orders);
+}
+
+template<Graph::VertexOrder order>
+static void BM_ShortestPathOnSparse(benchmark::State& state) {
+  int side = state.range(0);
+  Graph graph(GenerateGrid(side, side, side, true), order);
+  RandomGenerator gen(0, graph.GetSize() - 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        graph.GetShortestPath(gen.GetValue(), gen.GetValue()));
+  }
 }
 
 static void CustomArguments(benchmark::internal::Benchmark* b) {
@@ -88,6 +172,49 @@ int main(int argc, char** argv) {
   BENCHMARK(BM_Transport<Chain>)
       ->Unit(benchmark::kMillisecond)
       ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Tree>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Ring>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Grid>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Composite>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Graph, BasicTrafficManager<Graph>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Clique, BasicTrafficManager<Clique>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Chain, BasicTrafficManager<Chain>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Tree, BasicTrafficManager<Tree>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Ring, BasicTrafficManager<Ring>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Grid, BasicTrafficManager<Grid>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_Transport<Composite, BasicTrafficManager<Composite>>)
+      ->Unit(benchmark::kMillisecond)
+      ->Apply(CustomArguments)->Iterations(3);
+  BENCHMARK(BM_ShortestPathOnSparse<Graph::VertexOrder::kInput>)
+      ->Unit(benchmark::kMillisecond)
+      ->Arg(100)->Arg(300)->Arg(1000);
+  BENCHMARK(BM_ShortestPathOnSparse<Graph::VertexOrder::kBreadthFirst>)
+      ->Unit(benchmark::kMillisecond)
+      ->Arg(100)->Arg(300)->Arg(1000);
+  BENCHMARK(BM_ShortestPathOnSparse<Graph::VertexOrder::kReverseCuthillMcKee>)
+      ->Unit(benchmark::kMillisecond)
+      ->Arg(100)->Arg(300)->Arg(1000);
+  RegisterSuiteBenchmarks();
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
   benchmark::Shutdown();
@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+"""Compares Google Benchmark JSON results with a stored baseline.
+
+    compare_benchmarks.py <baseline.json> <current.json>
+        [--tolerance 0.25] [--metric cpu_time] [--statistic min]
+        [--allow-missing-baseline]
+
+Prints a table with relative change of every benchmark and exits with code 1
+if any of them became slower than baseline by more than the tolerance.
+When benchmarks were run with repetitions, the fastest runs are compared by
+default, since noise from other processes only makes runs slower.
+A missing baseline is an error, unless --allow-missing-baseline is given.
+Uses only the standard library.
+"""
+
+import argparse
+import json
+import os
+import statistics
+import sys
+
+# multipliers converting 'time_unit' of results into nanoseconds
+TIME_UNITS = {"ns": 1, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+STATISTICS = {"min": min, "median": statistics.median}
+
+
+def load_results(path, metric, statistic):
+    with open(path) as file:
+        data = json.load(file)
+    runs = {}
+    for benchmark in data.get("benchmarks", []):
+        # aggregates (mean, median, ...) are recomputed from single runs
+        if benchmark.get("run_type", "iteration") != "iteration":
+            continue
+        if "error_occurred" in benchmark:
+            continue
+        name = benchmark.get("run_name", benchmark["name"])
+        value = benchmark[metric] * TIME_UNITS[benchmark.get("time_unit", "ns")]
+        runs.setdefault(name, []).append(value)
+    summary = {name: STATISTICS[statistic](values)
+               for name, values in runs.items()}
+    return data.get("context", {}), summary
+
+
+def format_time(ns):
+    for unit, multiplier in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= multiplier:
+            return "%.3g %s" % (ns / multiplier, unit)
+    return "%.3g ns" % ns
+
+
+def warn_about_context(baseline, current):
+    for key in ("build_type", "num_cpus", "mhz_per_cpu", "library_build_type"):
+        if key in baseline and baseline.get(key) != current.get(key):
+            print("warning: %s differs: baseline has %s, current run has %s"
+                  % (key, baseline.get(key), current.get(key)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--tolerance", type=float, default=0.25,
+                        help="allowed relative slowdown, 0.25 means 25%%")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"),
+                        default="cpu_time")
+    parser.add_argument("--statistic", choices=sorted(STATISTICS),
+                        default="min",
+                        help="how repetitions of a benchmark are combined")
+    parser.add_argument("--allow-missing-baseline", action="store_true",
+                        help="succeed without comparison if there is no "
+                        "baseline")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print("no baseline at %s, record one with the perf_update_baseline "
+              "target of a Release build" % args.baseline)
+        return 0 if args.allow_missing_baseline else 1
+    baseline_context, baseline = load_results(
+        args.baseline, args.metric, args.statistic)
+    current_context, current = load_results(
+        args.current, args.metric, args.statistic)
+    warn_about_context(baseline_context, current_context)
+
+    rows = []
+    regressions = 0
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in current:
+            rows.append((name, format_time(baseline[name]), "-", "-",
+                         "missing"))
+            continue
+        if name not in baseline:
+            rows.append((name, "-", format_time(current[name]), "-", "new"))
+            continue
+        change = current[name] / baseline[name] - 1
+        if change > args.tolerance:
+            status = "REGRESSION"
+            regressions += 1
+        elif change < -args.tolerance:
+            status = "faster"
+        else:
+            status = "ok"
+        rows.append((name, format_time(baseline[name]),
+                     format_time(current[name]), "%+.1f%%" % (change * 100),
+                     status))
+
+    header = ("benchmark", "baseline", "current", "change", "status")
+    widths = [max(len(row[i]) for row in rows + [header])
+              for i in range(len(header))]
+    for row in [header] + rows:
+        print("  ".join(cell.ljust(width) if i == 0 else cell.rjust(width)
+                        for i, (cell, width) in enumerate(zip(row, widths))))
+
+    print("\n%d of %d benchmarks regressed by more than %.0f%% (%s)"
+          % (regressions, len(rows), args.tolerance * 100, args.metric))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
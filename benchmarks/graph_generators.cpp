@@ -0,0 +1,248 @@
+#include "graph_generators.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace {
+
+const int kMaxEdgeLength = 100;
+
+void AddEdge(AdjacencyList* list, int from, int to, int length) {
+  (*list)[from].emplace_back(to, length);
+  (*list)[to].emplace_back(from, length);
+}
+
+int GetRandomLength(std::mt19937_64* gen) {
+  return std::uniform_int_distribution<int>(1, kMaxEdgeLength)(*gen);
+}
+
+// links connected components into a chain, so every vertex is reachable
+void ConnectComponents(AdjacencyList* list, std::mt19937_64* gen) {
+  int n = list->size();
+  std::vector<bool> is_used(n, false);
+  std::vector<int> queue;
+  int previous_component = -1;
+
+  for (int start = 0; start < n; ++start) {
+    if (is_used[start]) {
+      continue;
+    }
+    if (previous_component != -1) {
+      AddEdge(list, previous_component, start, GetRandomLength(gen));
+    }
+    previous_component = start;
+
+    is_used[start] = true;
+    queue.assign(1, start);
+    for (int head = 0; head < queue.size(); ++head) {
+      for (const auto& edge : (*list)[queue[head]]) {
+        if (!is_used[edge.to]) {
+          is_used[edge.to] = true;
+          queue.push_back(edge.to);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+const char* GetGraphFamilyName(GraphFamily family) {
+  switch (family) {
+    case GraphFamily::kGrid:
+      return "Grid";
+    case GraphFamily::kRandomGeometric:
+      return "RandomGeometric";
+    case GraphFamily::kScaleFree:
+      return "ScaleFree";
+    case GraphFamily::kLongChain:
+      return "LongChain";
+    case GraphFamily::kClusters:
+      return "Clusters";
+  }
+  return "";
+}
+
+AdjacencyList GenerateGraph(GraphFamily family, int n, uint64_t seed) {
+  assert(n > 0);
+  switch (family) {
+    case GraphFamily::kGrid: {
+      int side = std::max(1, static_cast<int>(std::sqrt(n)));
+      return GenerateGrid(side, (n + side - 1) / side, seed);
+    }
+    case GraphFamily::kRandomGeometric:
+      return GenerateRandomGeometric(n, seed);
+    case GraphFamily::kScaleFree:
+      return GenerateScaleFree(n, 2, seed);
+    case GraphFamily::kLongChain:
+      return GenerateLongChain(n, seed);
+    case GraphFamily::kClusters: {
+      const int kClusterSize = 10;
+      return GenerateClusters((n + kClusterSize - 1) / kClusterSize,
+                              kClusterSize,
+                              seed);
+    }
+  }
+  return {};
+}
+
+AdjacencyList GenerateGrid(int rows, int columns, uint64_t seed,
+                           bool shuffle) {
+  std::mt19937_64 gen(seed);
+  std::vector<int> labels(rows * columns);
+  std::iota(labels.begin(), labels.end(), 0);
+  if (shuffle) {
+    std::shuffle(labels.begin(), labels.end(), gen);
+  }
+
+  AdjacencyList list(rows * columns);
+  for (int row = 0; row < rows; ++row) {
+    for (int column = 0; column < columns; ++column) {
+      int vertex = row * columns + column;
+      if (column + 1 < columns) {
+        AddEdge(&list, labels[vertex], labels[vertex + 1],
+                GetRandomLength(&gen));
+      }
+      if (row + 1 < rows) {
+        AddEdge(&list, labels[vertex], labels[vertex + columns],
+                GetRandomLength(&gen));
+      }
+    }
+  }
+  return list;
+}
+
+AdjacencyList GenerateRandomGeometric(int n, uint64_t seed) {
+  // gives 6 neighbours per vertex on average
+  const double kAverageDegree = 6;
+  double radius = std::sqrt(kAverageDegree / (M_PI * n));
+
+  std::mt19937_64 gen(seed);
+  std::uniform_real_distribution<double> coordinate(0, 1);
+  std::vector<std::pair<double, double>> points(n);
+  for (auto& [x, y] : points) {
+    x = coordinate(gen);
+    y = coordinate(gen);
+  }
+
+  // points are bucketed into cells with side 'radius', so only neighbouring
+  // cells have to be checked
+  int cells_per_side = std::max(1, static_cast<int>(1 / radius));
+  auto get_cell = [cells_per_side](double coordinate) {
+    return std::min(cells_per_side - 1,
+                    static_cast<int>(coordinate * cells_per_side));
+  };
+  std::vector<std::vector<int>> cells(cells_per_side * cells_per_side);
+  for (int i = 0; i < n; ++i) {
+    cells[get_cell(points[i].first) * cells_per_side +
+        get_cell(points[i].second)].push_back(i);
+  }
+
+  AdjacencyList list(n);
+  for (int i = 0; i < n; ++i) {
+    int cell_x = get_cell(points[i].first);
+    int cell_y = get_cell(points[i].second);
+    for (int x = std::max(0, cell_x - 1);
+         x <= std::min(cells_per_side - 1, cell_x + 1); ++x) {
+      for (int y = std::max(0, cell_y - 1);
+           y <= std::min(cells_per_side - 1, cell_y + 1); ++y) {
+        for (int j : cells[x * cells_per_side + y]) {
+          double distance = std::hypot(points[i].first - points[j].first,
+                                       points[i].second - points[j].second);
+          if (i < j && distance <= radius) {
+            int length = static_cast<int>(distance / radius * kMaxEdgeLength);
+            AddEdge(&list, i, j, std::max(1, length));
+          }
+        }
+      }
+    }
+  }
+
+  ConnectComponents(&list, &gen);
+  return list;
+}
+
+AdjacencyList GenerateScaleFree(int n, int edges_per_vertex, uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  AdjacencyList list(n);
+  // every vertex appears here once per incident edge
+  std::vector<int> endpoints;
+
+  for (int vertex = 1; vertex < n; ++vertex) {
+    std::vector<int> targets;
+    if (endpoints.empty()) {
+      targets.push_back(0);
+    }
+    for (int i = 0; i < edges_per_vertex && !endpoints.empty(); ++i) {
+      int target = endpoints[std::uniform_int_distribution<int>(
+          0, endpoints.size() - 1)(gen)];
+      if (std::find(targets.begin(), targets.end(), target) ==
+          targets.end()) {
+        targets.push_back(target);
+      }
+    }
+    for (int target : targets) {
+      AddEdge(&list, vertex, target, GetRandomLength(&gen));
+      endpoints.push_back(vertex);
+      endpoints.push_back(target);
+    }
+  }
+  return list;
+}
+
+AdjacencyList GenerateLongChain(int n, uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<int> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), gen);
+
+  AdjacencyList list(n);
+  for (int i = 0; i + 1 < n; ++i) {
+    AddEdge(&list, order[i], order[i + 1], GetRandomLength(&gen));
+  }
+  return list;
+}
+
+AdjacencyList GenerateClusters(int clusters_count,
+                               int cluster_size,
+                               uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int> member(0, cluster_size - 1);
+  std::uniform_int_distribution<int> city_length(1, kMaxEdgeLength / 10);
+  std::uniform_int_distribution<int> highway_length(kMaxEdgeLength / 2,
+                                                    kMaxEdgeLength * 5);
+  AdjacencyList list(clusters_count * cluster_size);
+
+  for (int cluster = 0; cluster < clusters_count; ++cluster) {
+    int first = cluster * cluster_size;
+    for (int i = 0; i < cluster_size; ++i) {
+      for (int j = i + 1; j < cluster_size; ++j) {
+        AddEdge(&list, first + i, first + j, city_length(gen));
+      }
+    }
+  }
+
+  // highways between neighbouring clusters and shortcuts from every fourth
+  // cluster to a random one
+  std::uniform_int_distribution<int> cluster_distribution(
+      0, clusters_count - 1);
+  auto add_highway = [&](int from_cluster, int to_cluster) {
+    if (from_cluster != to_cluster) {
+      AddEdge(&list,
+              from_cluster * cluster_size + member(gen),
+              to_cluster * cluster_size + member(gen),
+              highway_length(gen));
+    }
+  };
+  for (int cluster = 0; cluster + 1 < clusters_count; ++cluster) {
+    add_highway(cluster, cluster + 1);
+    if (cluster % 4 == 0) {
+      add_highway(cluster, cluster_distribution(gen));
+    }
+  }
+
+  return list;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/Graphs/AbstractGraph/abstract_graph.h"
+
+// Generators of connected undirected road-like graphs as adjacency lists.
+// The same seed always produces the same graph.
+
+using AdjacencyList = std::vector<std::vector<AbstractGraph::Edge>>;
+
+enum class GraphFamily {
+  kGrid,
+  kRandomGeometric,
+  kScaleFree,
+  kLongChain,
+  kClusters,
+};
+
+const char* GetGraphFamilyName(GraphFamily family);
+
+// generates graph of the family with approximately n vertices
+AdjacencyList GenerateGraph(GraphFamily family, int n, uint64_t seed);
+
+// rows x columns grid with random edge lengths, if 'shuffle' is set vertices
+// are numbered randomly, like in imported datasets
+AdjacencyList GenerateGrid(int rows, int columns, uint64_t seed,
+                           bool shuffle = false);
+// random points in a unit square, connected when they are close enough,
+// edge lengths are proportional to distances between points
+AdjacencyList GenerateRandomGeometric(int n, uint64_t seed);
+// preferential attachment: every new vertex is connected to
+// 'edges_per_vertex' vertices chosen with probability proportional to degree
+AdjacencyList GenerateScaleFree(int n, int edges_per_vertex, uint64_t seed);
+// path through all vertices in random order
+AdjacencyList GenerateLongChain(int n, uint64_t seed);
+// dense clusters of 'cluster_size' vertices, linked into a sparse network
+AdjacencyList GenerateClusters(int clusters_count,
+                               int cluster_size,
+                               uint64_t seed);
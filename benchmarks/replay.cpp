@@ -0,0 +1,111 @@
+// Replays a recorded trace of TrafficManager calls on a graph from file:
+//   Replay <graph file> <trace file>
+// and reports throughput, latency histogram and checksum of the final state,
+// see src/Trace/trace.h for file formats.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Metrics/metrics.h"
+#include "../src/Trace/trace.h"
+#include "../src/TrafficManager/traffic_manager.h"
+
+namespace {
+
+// bucket i counts latencies in [2^i, 2^(i + 1)) nanoseconds
+void PrintLatencyHistogram(const std::vector<int64_t>& sorted_latencies) {
+  std::vector<int> buckets;
+  for (int64_t latency : sorted_latencies) {
+    int bucket = 0;
+    while ((int64_t{2} << bucket) <= latency) {
+      ++bucket;
+    }
+    if (bucket >= buckets.size()) {
+      buckets.resize(bucket + 1);
+    }
+    ++buckets[bucket];
+  }
+
+  std::cout << "latency histogram (ns):\n";
+  for (int bucket = 0; bucket < buckets.size(); ++bucket) {
+    if (buckets[bucket] != 0) {
+      std::cout << "  [" << (int64_t{1} << bucket) << ", "
+                << (int64_t{2} << bucket) << "): " << buckets[bucket] << '\n';
+    }
+  }
+  for (int percentile : {50, 90, 99}) {
+    std::cout << "p" << percentile << ": "
+              << sorted_latencies[(sorted_latencies.size() - 1) *
+                  percentile / 100] << " ns\n";
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <graph file> <trace file>\n";
+    return 1;
+  }
+
+  std::ifstream graph_file(argv[1]);
+  auto list = ReadGraph(graph_file);
+  if (!list) {
+    std::cerr << "can't read graph from " << argv[1] << '\n';
+    return 1;
+  }
+  std::ifstream trace_file(argv[2]);
+  auto trace = ReadTrace(trace_file);
+  if (!trace) {
+    std::cerr << "can't read trace from " << argv[2] << '\n';
+    return 1;
+  }
+
+  Graph graph(std::move(*list));
+  auto traffic_manager = CreateTraceManager(&graph, *trace);
+
+  std::vector<int64_t> latencies;
+  latencies.reserve(trace->operations.size());
+  int64_t results_sum = 0;
+  for (int i = 0; i < trace->operations.size(); ++i) {
+    const auto& operation = trace->operations[i];
+    if (!IsValidOperation(traffic_manager, operation)) {
+      std::cerr << "operation " << i << " ("
+                << GetOperationName(operation.type) << ") of " << argv[2]
+                << " doesn't match the graph or the state\n";
+      return 1;
+    }
+    auto start = std::chrono::steady_clock::now();
+    results_sum += ApplyOperation(&traffic_manager, operation);
+    auto finish = std::chrono::steady_clock::now();
+    latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        finish - start).count());
+  }
+
+  int64_t total_ns = 0;
+  for (int64_t latency : latencies) {
+    total_ns += latency;
+  }
+  std::cout << "operations: " << latencies.size() << '\n';
+  std::cout << "total time: " << total_ns / 1'000'000.0 << " ms\n";
+  if (total_ns > 0) {
+    std::cout << "throughput: " << latencies.size() * 1e9 / total_ns
+              << " operations/s\n";
+  }
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    PrintLatencyHistogram(latencies);
+  }
+  std::cout << "sum of results: " << results_sum << '\n';
+  std::cout << "final state checksum: " << std::hex
+            << GetStateChecksum(traffic_manager) << '\n';
+  if (metrics::IsEnabled()) {
+    std::cout << std::dec << metrics::Collect().ToText();
+  }
+  return 0;
+}
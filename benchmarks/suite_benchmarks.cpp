@@ -0,0 +1,343 @@
+#include "suite_benchmarks.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "../src/Graphs/Algorithms/delta_stepping.h"
+#include "../src/Graphs/Algorithms/hub_labels.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/TrafficManager/traffic_manager.h"
+#include "graph_generators.h"
+
+class TrafficManagerTester {
+ public:
+  static int MoveClosestVehicles(BasicTrafficManager<Graph>* traffic_manager,
+                                 int to,
+                                 int count) {
+    return traffic_manager->MoveClosestVehicles(to, count);
+  }
+};
+
+namespace {
+
+// every run uses the same graphs and queries
+const uint64_t kSeed = 20220314;
+
+const std::vector<GraphFamily> kGraphFamilies = {
+    GraphFamily::kGrid,
+    GraphFamily::kRandomGeometric,
+    GraphFamily::kScaleFree,
+    GraphFamily::kLongChain,
+    GraphFamily::kClusters,
+};
+
+// generated graphs are shared between benchmarks
+const Graph& GetGraph(GraphFamily family, int n) {
+  static std::map<std::pair<GraphFamily, int>, std::unique_ptr<Graph>> graphs;
+  auto& graph = graphs[{family, n}];
+  if (!graph) {
+    graph = std::make_unique<Graph>(GenerateGraph(family, n, kSeed));
+  }
+  return *graph;
+}
+
+class TownGenerator {
+ public:
+  explicit TownGenerator(int towns_count)
+      : distribution_(0, towns_count - 1) {}
+
+  int GetTown() {
+    return distribution_(gen_);
+  }
+
+ private:
+  std::mt19937_64 gen_{kSeed};
+  std::uniform_int_distribution<int> distribution_;
+};
+
+void BM_GetShortestPath(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  TownGenerator towns(graph.GetSize());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        graph.GetShortestPath(towns.GetTown(), towns.GetTown()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetShortestPaths(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  TownGenerator towns(graph.GetSize());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph.GetShortestPaths(towns.GetTown()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_GetEdges(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  TownGenerator towns(graph.GetSize());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(graph.GetEdges(towns.GetTown()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_MoveClosestVehicles(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int n = graph.GetSize();
+  TownGenerator towns(n);
+  // every 100-th town has vehicles, so searches have to go far enough
+  std::vector<int> vehicles(n, 0);
+  for (int town = 0; town < n; town += 100) {
+    vehicles[town] = 10;
+  }
+  BasicTrafficManager<Graph> traffic_manager(&graph,
+                                             std::vector<int>(n, 0),
+                                             vehicles,
+                                             1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(TrafficManagerTester::MoveClosestVehicles(
+        &traffic_manager, towns.GetTown(), 5));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_TransportWithReturns(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int n = graph.GetSize();
+  TownGenerator towns(n);
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int> buns_distribution(1, 100);
+  std::uniform_int_distribution<int> vehicles_distribution(0, 3);
+  std::vector<int> vehicles(n);
+  for (auto& town_vehicles : vehicles) {
+    town_vehicles = vehicles_distribution(gen);
+  }
+  vehicles[0] = 1;
+  BasicTrafficManager<Graph> traffic_manager(&graph,
+                                             std::vector<int>(n, 100'000),
+                                             vehicles,
+                                             10);
+  for (auto _ : state) {
+    int from = towns.GetTown();
+    int to = towns.GetTown();
+    int buns_amount = std::min(buns_distribution(gen),
+                               traffic_manager.GetBunsAmount(from));
+    benchmark::DoNotOptimize(
+        traffic_manager.TransportWithReturns(from, to, buns_amount));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// 20 towns need 5 vehicles each at the same time, every 10-th town has one,
+// 'dispatch' is true for DispatchVehicles and false for a MoveClosestVehicles
+// call per town
+void BenchmarkShortfalls(benchmark::State& state,
+                         GraphFamily family,
+                         bool dispatch) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int n = graph.GetSize();
+  TownGenerator towns(n);
+  std::vector<int> vehicles(n, 0);
+  for (int town = 0; town < n; town += 10) {
+    vehicles[town] = 1;
+  }
+  BasicTrafficManager<Graph> traffic_manager(&graph,
+                                             std::vector<int>(n, 0),
+                                             vehicles,
+                                             1);
+  const int kShortfallsCount = 20;
+  const int kVehiclesNeeded = 5;
+  std::vector<int> vehicles_needed(n, 0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    traffic_manager.SetVehicles(vehicles);
+    std::fill(vehicles_needed.begin(), vehicles_needed.end(), 0);
+    for (int i = 0; i < kShortfallsCount; ++i) {
+      vehicles_needed[towns.GetTown()] = kVehiclesNeeded;
+    }
+    state.ResumeTiming();
+    if (dispatch) {
+      benchmark::DoNotOptimize(
+          traffic_manager.DispatchVehicles(vehicles_needed));
+    } else {
+      for (int town = 0; town < n; ++town) {
+        int shortfall = vehicles_needed[town] - vehicles[town];
+        if (shortfall > 0) {
+          benchmark::DoNotOptimize(TrafficManagerTester::MoveClosestVehicles(
+              &traffic_manager, town, shortfall));
+        }
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kShortfallsCount);
+}
+
+void BM_DispatchVehicles(benchmark::State& state, GraphFamily family) {
+  BenchmarkShortfalls(state, family, true);
+}
+
+void BM_SequentialMoveClosestVehicles(benchmark::State& state,
+                                      GraphFamily family) {
+  BenchmarkShortfalls(state, family, false);
+}
+
+// every 10-th town gives its buns to a random town
+void BM_Redistribute(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int n = graph.GetSize();
+  TownGenerator towns(n);
+  std::vector<int> buns_amounts(n, 100);
+  std::vector<int> target_buns_amounts = buns_amounts;
+  for (int town = 0; town < n; town += 10) {
+    target_buns_amounts[town] -= 50;
+    target_buns_amounts[towns.GetTown()] += 50;
+  }
+  BasicTrafficManager<Graph> traffic_manager(&graph,
+                                             buns_amounts,
+                                             std::vector<int>(n, 1),
+                                             10);
+  for (auto _ : state) {
+    state.PauseTiming();
+    traffic_manager.SetBunsAmounts(buns_amounts);
+    traffic_manager.SetVehicles(std::vector<int>(n, 1));
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        traffic_manager.Redistribute(target_buns_amounts));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// 20 small deliveries from a random town, every 10-th town has vehicles
+void BM_TransportWithTours(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int n = graph.GetSize();
+  TownGenerator towns(n);
+  std::mt19937_64 gen(kSeed);
+  std::uniform_int_distribution<int> buns_distribution(1, 10);
+  std::vector<int> vehicles(n, 0);
+  for (int town = 0; town < n; town += 10) {
+    vehicles[town] = 100;
+  }
+  BasicTrafficManager<Graph> traffic_manager(&graph,
+                                             std::vector<int>(n, 0),
+                                             vehicles,
+                                             10);
+  const int kDeliveriesCount = 20;
+  std::vector<BasicTrafficManager<Graph>::Delivery> deliveries(
+      kDeliveriesCount);
+  for (auto _ : state) {
+    state.PauseTiming();
+    traffic_manager.SetVehicles(vehicles);
+    int from = towns.GetTown();
+    for (auto& [to, buns_amount] : deliveries) {
+      to = towns.GetTown();
+      buns_amount = buns_distribution(gen);
+    }
+    traffic_manager.SetBunsAmount(from, kDeliveriesCount * 10);
+    state.ResumeTiming();
+    benchmark::DoNotOptimize(
+        traffic_manager.TransportWithTours(from, deliveries));
+  }
+  state.SetItemsProcessed(state.iterations() * kDeliveriesCount);
+}
+
+// whole shortest path tree, 'state.range(1)' is the number of threads of
+// delta-stepping, 0 means sequential Dijkstra
+void BM_ShortestPathTree(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  int threads_count = state.range(1);
+  TownGenerator towns(graph.GetSize());
+  algorithms::SearchWorkspace tree;
+  // the calling thread is one of them
+  executor::ThreadPool thread_pool(std::max(1, threads_count - 1));
+  for (auto _ : state) {
+    if (threads_count == 0) {
+      algorithms::Dijkstra(graph, towns.GetTown(), &tree);
+    } else {
+      algorithms::DeltaStepping(graph, towns.GetTown(),
+                                {threads_count, 0, &thread_pool}, &tree);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * graph.GetSize());
+}
+
+// distance queries of hub labels, compare with BM_GetShortestPath; labels
+// are built once per graph on the default executor, which takes a while for
+// larger ones
+void BM_HubLabelsDistance(benchmark::State& state, GraphFamily family) {
+  const Graph& graph = GetGraph(family, state.range(0));
+  static std::map<const Graph*, algorithms::HubLabels> all_hub_labels;
+  auto [it, is_new] = all_hub_labels.try_emplace(&graph);
+  if (is_new) {
+    it->second = algorithms::HubLabels::Build(graph);
+  }
+  const algorithms::HubLabels& hub_labels = it->second;
+  TownGenerator towns(graph.GetSize());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        hub_labels.GetDistance(towns.GetTown(), towns.GetTown()));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["labels_per_vertex"] =
+      static_cast<double>(hub_labels.GetLabelsSize()) / graph.GetSize();
+}
+
+}  // namespace
+
+void RegisterSuiteBenchmarks() {
+  using BenchmarkFunction = void (*)(benchmark::State&, GraphFamily);
+  // functions, which results size is linear in graph size, are limited to
+  // smaller graphs
+  const std::vector<std::pair<std::string, BenchmarkFunction>> kLarge = {
+      {"BM_GetShortestPath", BM_GetShortestPath},
+      {"BM_GetEdges", BM_GetEdges},
+      {"BM_MoveClosestVehicles", BM_MoveClosestVehicles},
+  };
+  const std::vector<std::pair<std::string, BenchmarkFunction>> kSmall = {
+      {"BM_GetShortestPaths", BM_GetShortestPaths},
+      {"BM_TransportWithReturns", BM_TransportWithReturns},
+      {"BM_DispatchVehicles", BM_DispatchVehicles},
+      {"BM_SequentialMoveClosestVehicles", BM_SequentialMoveClosestVehicles},
+      {"BM_Redistribute", BM_Redistribute},
+      {"BM_TransportWithTours", BM_TransportWithTours},
+  };
+
+  for (auto family : kGraphFamilies) {
+    std::string family_name = GetGraphFamilyName(family);
+    for (const auto& [name, function] : kLarge) {
+      benchmark::RegisterBenchmark((name + "/" + family_name).c_str(),
+                                   function,
+                                   family)
+          ->Unit(benchmark::kMicrosecond)
+          ->RangeMultiplier(10)->Range(1'000, 1'000'000);
+    }
+    for (const auto& [name, function] : kSmall) {
+      benchmark::RegisterBenchmark((name + "/" + family_name).c_str(),
+                                   function,
+                                   family)
+          ->Unit(benchmark::kMicrosecond)
+          ->Arg(1'000)->Arg(3'000);
+    }
+    benchmark::RegisterBenchmark(
+        ("BM_ShortestPathTree/" + family_name).c_str(),
+        BM_ShortestPathTree,
+        family)
+        ->Unit(benchmark::kMillisecond)
+        ->ArgsProduct({{100'000, 1'000'000}, {0, 1, 2, 4, 8}})
+        ->UseRealTime();
+    benchmark::RegisterBenchmark(
+        ("BM_HubLabelsDistance/" + family_name).c_str(),
+        BM_HubLabelsDistance,
+        family)
+        ->Unit(benchmark::kMicrosecond)
+        ->Arg(1'000)->Arg(10'000);
+  }
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+// registers micro-benchmarks of graph and TrafficManager operations on
+// generated road-like graphs with up to 1'000'000 vertices
+void RegisterSuiteBenchmarks();
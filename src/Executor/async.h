@@ -0,0 +1,156 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "executor.h"
+
+// C++20 coroutines on top of executors. Async<T> is a lazy coroutine: it
+// starts, when it's awaited, and resumes the awaiting coroutine on the
+// thread, where it finishes. co_await Schedule(executor) moves the rest of
+// a coroutine to a thread of the executor, e.g. to a worker pool for heavy
+// work and back to the event loop of an application for the result.
+
+namespace executor {
+
+template<typename T>
+class [[nodiscard]] Async {
+ public:
+  struct promise_type {
+    Async get_return_object() {
+      return Async(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept {
+      return {};
+    }
+    auto final_suspend() noexcept {
+      struct ResumeContinuation {
+        bool await_ready() noexcept {
+          return false;
+        }
+        std::coroutine_handle<> await_suspend(
+            std::coroutine_handle<promise_type> handle) noexcept {
+          return handle.promise().continuation;
+        }
+        void await_resume() noexcept {}
+      };
+      return ResumeContinuation{};
+    }
+    void return_value(T value) {
+      result.emplace(std::move(value));
+    }
+    void unhandled_exception() {
+      std::terminate();
+    }
+
+    std::optional<T> result;
+    std::coroutine_handle<> continuation{std::noop_coroutine()};
+  };
+
+  Async(Async&& other) noexcept
+      : handle_(std::exchange(other.handle_, nullptr)) {}
+  Async& operator=(Async&& other) noexcept {
+    std::swap(handle_, other.handle_);
+    return *this;
+  }
+  ~Async() {
+    if (handle_) {
+      handle_.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) {
+    handle_.promise().continuation = continuation;
+    return handle_;
+  }
+  T await_resume() {
+    return std::move(*handle_.promise().result);
+  }
+
+ private:
+  explicit Async(std::coroutine_handle<promise_type> handle)
+      : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+// co_await Schedule(executor) resumes the coroutine on 'executor'
+inline auto Schedule(Executor& executor) {
+  struct Awaiter {
+    bool await_ready() const noexcept {
+      return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) {
+      executor.Submit([handle] {
+        handle.resume();
+      });
+    }
+    void await_resume() const noexcept {}
+
+    Executor& executor;
+  };
+  return Awaiter{executor};
+}
+
+namespace async_details {
+
+// coroutine, which starts at once and destroys itself, when it finishes
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() {
+      return {};
+    }
+    std::suspend_never initial_suspend() noexcept {
+      return {};
+    }
+    std::suspend_never final_suspend() noexcept {
+      return {};
+    }
+    void return_void() {}
+    void unhandled_exception() {
+      std::terminate();
+    }
+  };
+};
+
+template<typename T>
+Detached RunDetached(Async<T> async, std::function<void(T)> callback) {
+  callback(co_await std::move(async));
+}
+
+}  // namespace async_details
+
+// starts 'async' on the calling thread, 'callback' gets its result on the
+// thread, where it finishes
+template<typename T>
+void Start(Async<T> async, std::function<void(T)> callback) {
+  async_details::RunDetached(std::move(async), std::move(callback));
+}
+
+// blocks the calling thread until 'async' finishes
+template<typename T>
+T SyncWait(Async<T> async) {
+  std::mutex mutex;
+  std::condition_variable done;
+  std::optional<T> result;
+  Start<T>(std::move(async), [&](T value) {
+    std::lock_guard lock(mutex);
+    result.emplace(std::move(value));
+    done.notify_one();
+  });
+  std::unique_lock lock(mutex);
+  done.wait(lock, [&result] {
+    return result.has_value();
+  });
+  return std::move(*result);
+}
+
+}  // namespace executor
@@ -0,0 +1,279 @@
+#include "executor.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace executor {
+
+namespace {
+
+// pool and queue of the worker, which runs on this thread
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+std::atomic<Executor*> default_executor{nullptr};
+
+struct ParallelForState {
+  const std::function<void(int, size_t, size_t)>* body{nullptr};
+  size_t end{0};
+  size_t grain{1};
+  std::atomic<size_t> cursor{0};
+
+  std::mutex mutex;
+  std::condition_variable done;
+  // slots, which are taking chunks now
+  int active{0};
+};
+
+void ProcessChunks(ParallelForState* state, int slot) {
+  size_t begin;
+  while ((begin = state->cursor.fetch_add(state->grain)) < state->end) {
+    (*state->body)(slot, begin, std::min(state->end, begin + state->grain));
+  }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int workers_count) {
+  if (workers_count <= 0) {
+    workers_count =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  queues_.reserve(workers_count);
+  for (int i = 0; i < workers_count; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  workers_.reserve(workers_count);
+  for (int i = 0; i < workers_count; ++i) {
+    workers_.emplace_back([this, i] {
+      Run(i);
+    });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    is_stopping_ = true;
+  }
+  wake_up_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Submit(Task task) {
+  size_t queue = current_pool == this
+      ? current_worker
+      : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  {
+    std::lock_guard lock(queues_[queue]->mutex);
+    queues_[queue]->tasks.push_back(std::move(task));
+  }
+  pending_.fetch_add(1);
+  {
+    // sleeping workers check 'pending_' under the mutex, so the notification
+    // can't be lost
+    std::lock_guard lock(sleep_mutex_);
+  }
+  wake_up_.notify_one();
+}
+
+int ThreadPool::GetConcurrency() const {
+  return workers_.size();
+}
+
+bool ThreadPool::RunPendingTask() {
+  Task task;
+  if (!TryPop(current_pool == this ? current_worker : 0, &task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+void ThreadPool::Run(int worker) {
+  current_pool = this;
+  current_worker = worker;
+  while (true) {
+    Task task;
+    if (TryPop(worker, &task)) {
+      task();
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_up_.wait(lock, [this] {
+      return pending_.load() > 0 || is_stopping_;
+    });
+    if (is_stopping_ && pending_.load() <= 0) {
+      break;
+    }
+  }
+}
+
+bool ThreadPool::TryPop(int worker, Task* task) {
+  for (int i = 0; i < queues_.size(); ++i) {
+    Queue& queue = *queues_[(worker + i) % queues_.size()];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      *task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    pending_.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+Strand::Strand(Executor* executor)
+    : executor_(executor ? executor : &GetDefaultExecutor()) {}
+
+void Strand::Submit(Task task) {
+  {
+    std::lock_guard lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (is_running_) {
+      return;
+    }
+    is_running_ = true;
+  }
+  executor_->Submit([this] {
+    Drain();
+  });
+}
+
+int Strand::GetConcurrency() const {
+  return 1;
+}
+
+void Strand::Drain() {
+  while (true) {
+    Task task;
+    {
+      std::lock_guard lock(mutex_);
+      if (tasks_.empty()) {
+        is_running_ = false;
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+Executor& GetDefaultExecutor() {
+  if (Executor* executor = default_executor.load()) {
+    return *executor;
+  }
+  static ThreadPool thread_pool;
+  return thread_pool;
+}
+
+void SetDefaultExecutor(Executor* executor) {
+  default_executor.store(executor);
+}
+
+TaskGroup::TaskGroup(Executor* executor)
+    : executor_(executor ? executor : &GetDefaultExecutor()),
+      state_(std::make_shared<State>()) {}
+
+TaskGroup::~TaskGroup() {
+  Wait();
+}
+
+void TaskGroup::Run(Executor::Task task) {
+  {
+    std::lock_guard lock(state_->mutex);
+    ++state_->running;
+  }
+  executor_->Submit([state = state_, task = std::move(task)] {
+    task();
+    std::lock_guard lock(state->mutex);
+    if (--state->running == 0) {
+      state->done.notify_all();
+    }
+  });
+}
+
+void TaskGroup::Wait() {
+  while (true) {
+    {
+      std::lock_guard lock(state_->mutex);
+      if (state_->running == 0) {
+        return;
+      }
+    }
+    if (!executor_->RunPendingTask()) {
+      break;
+    }
+  }
+  // remaining tasks are running on other threads
+  std::unique_lock lock(state_->mutex);
+  state_->done.wait(lock, [this] {
+    return state_->running == 0;
+  });
+}
+
+int GetSlotsCount(const Executor& executor) {
+  return executor.GetConcurrency() + 1;
+}
+
+void ParallelFor(
+    Executor& executor,
+    size_t begin,
+    size_t end,
+    size_t grain,
+    const std::function<void(int slot, size_t begin, size_t end)>& body,
+    int slots_count) {
+  assert(grain > 0);
+  if (begin >= end) {
+    return;
+  }
+  if (slots_count <= 0) {
+    slots_count = GetSlotsCount(executor);
+  }
+  size_t chunks_count = (end - begin + grain - 1) / grain;
+  int helpers_count = std::min<size_t>(slots_count - 1, chunks_count - 1);
+  if (helpers_count == 0) {
+    for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += grain) {
+      body(0, chunk_begin, std::min(end, chunk_begin + grain));
+    }
+    return;
+  }
+
+  // helpers may start after the loop is over, so the state is shared with
+  // them; they don't touch 'body' then, since no chunks are left
+  auto state = std::make_shared<ParallelForState>();
+  state->body = &body;
+  state->end = end;
+  state->grain = grain;
+  state->cursor.store(begin);
+  for (int slot = 1; slot <= helpers_count; ++slot) {
+    executor.Submit([state, slot] {
+      {
+        std::lock_guard lock(state->mutex);
+        ++state->active;
+      }
+      ProcessChunks(state.get(), slot);
+      std::lock_guard lock(state->mutex);
+      if (--state->active == 0) {
+        state->done.notify_all();
+      }
+    });
+  }
+  ProcessChunks(state.get(), 0);
+
+  std::unique_lock lock(state->mutex);
+  state->done.wait(lock, [&state] {
+    return state->active == 0;
+  });
+}
+
+}  // namespace executor
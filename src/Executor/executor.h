@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Parallel work of the library goes through Executor, so an application,
+// which owns its threads, can run it on them by implementing the interface
+// and passing it to SetDefaultExecutor() (or to a single call).
+// ThreadPool is the default implementation: every worker has its own deque
+// of tasks, it takes tasks from its back and steals tasks of other workers
+// from their fronts, when it has none.
+
+namespace executor {
+
+class Executor {
+ public:
+  using Task = std::function<void()>;
+
+  virtual ~Executor() = default;
+
+  // task must be run exactly once, possibly on the calling thread
+  virtual void Submit(Task task) = 0;
+  // number of tasks, which can run at the same time
+  virtual int GetConcurrency() const = 0;
+  // runs one of submitted tasks on the calling thread, returns false if
+  // there are none; waiting threads help with the work through it
+  virtual bool RunPendingTask() {
+    return false;
+  }
+};
+
+class ThreadPool : public Executor {
+ public:
+  // 0 means std::thread::hardware_concurrency()
+  explicit ThreadPool(int workers_count = 0);
+  // runs all submitted tasks before joining workers
+  ~ThreadPool() override;
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Submit(Task task) override;
+  int GetConcurrency() const override;
+  bool RunPendingTask() override;
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void Run(int worker);
+  // own tasks are taken from the back, others are stolen from the front
+  bool TryPop(int worker, Task* task);
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  // tasks in queues, workers sleep while there are none
+  std::atomic<int64_t> pending_{0};
+  // queue for tasks submitted by threads, which are not workers
+  std::atomic<size_t> next_queue_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+  bool is_stopping_{false};
+};
+
+// Runs tasks one at a time in order of submission on another executor, so
+// they don't need locks for state they share. It must not be destroyed while
+// it has tasks.
+class Strand : public Executor {
+ public:
+  // nullptr means GetDefaultExecutor()
+  explicit Strand(Executor* executor = nullptr);
+
+  Strand(const Strand&) = delete;
+  Strand& operator=(const Strand&) = delete;
+
+  void Submit(Task task) override;
+  int GetConcurrency() const override;
+
+ private:
+  void Drain();
+
+  Executor* executor_;
+  std::mutex mutex_;
+  std::deque<Task> tasks_;
+  // whether some thread runs tasks of the strand
+  bool is_running_{false};
+};
+
+// ThreadPool with all hardware threads, unless replaced
+Executor& GetDefaultExecutor();
+// nullptr restores the ThreadPool, 'executor' must outlive its use
+void SetDefaultExecutor(Executor* executor);
+
+// Runs tasks on an executor and waits for all of them. Waiting thread runs
+// pending tasks of the executor meanwhile, so tasks of a ThreadPool can wait
+// for their own groups.
+class TaskGroup {
+ public:
+  explicit TaskGroup(Executor* executor = nullptr);
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+  void Run(Executor::Task task);
+  void Wait();
+
+ private:
+  struct State {
+    std::mutex mutex;
+    std::condition_variable done;
+    int running{0};
+  };
+
+  Executor* executor_;
+  std::shared_ptr<State> state_;
+};
+
+// number of threads ParallelFor uses with 'executor': its own ones and the
+// calling thread
+int GetSlotsCount(const Executor& executor);
+
+// Calls body(slot, chunk_begin, chunk_end) for chunks of at most 'grain'
+// indices, which cover [begin, end). Chunks with the same slot are never
+// processed at the same time, so per-slot state needs no locks; slots are in
+// [0, slots_count), 0 means GetSlotsCount(executor). The calling thread takes
+// chunks too, so the loop finishes even when tasks of the executor don't
+// start, e.g. when all its threads are busy.
+void ParallelFor(
+    Executor& executor,
+    size_t begin,
+    size_t end,
+    size_t grain,
+    const std::function<void(int slot, size_t begin, size_t end)>& body,
+    int slots_count = 0);
+
+}  // namespace executor
@@ -1,5 +1,6 @@
 #include "abstract_graph.h"
 
+#include <algorithm>
 #include <cassert>
 
 AbstractGraph::AbstractGraph(int n) : n_(n) {}
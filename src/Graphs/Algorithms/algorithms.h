@@ -0,0 +1,420 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../Metrics/metrics.h"
+#include "../AbstractGraph/abstract_graph.h"
+#include "search_workspace.h"
+
+// Generic graph algorithms. They work with any storage satisfying
+// GraphStorage and are instantiated separately for every storage, so calls
+// to it are resolved at compile time when its type is final.
+namespace algorithms {
+
+// vertices are numbered from 0 to GetSize() - 1, GetEdges(from) returns range
+// of edges with 'to' and integral 'length' fields
+template<typename GraphType>
+concept GraphStorage = requires(const GraphType& graph, int vertex) {
+  { graph.GetSize() } -> std::convertible_to<int>;
+  { graph.GetEdges(vertex) } -> std::ranges::input_range;
+} && requires(std::ranges::range_value_t<
+    decltype(std::declval<const GraphType&>().GetEdges(0))> edge) {
+  { edge.to } -> std::convertible_to<int>;
+  requires std::integral<std::remove_cvref_t<decltype(edge.length)>>;
+};
+
+template<typename GraphType>
+struct DistanceTypeOf {
+  using type = std::common_type_t<
+      int,
+      std::remove_cvref_t<decltype(std::ranges::range_value_t<
+          decltype(std::declval<const GraphType&>().GetEdges(0))>::length)>>;
+};
+template<typename GraphType>
+  requires requires { typename GraphType::Distance; }
+struct DistanceTypeOf<GraphType> {
+  using type = typename GraphType::Distance;
+};
+
+// type of distances in searches over the storage: 'Distance' member type of
+// the storage if it has one, so long paths of int edges can be int64_t,
+// otherwise the type of edge lengths, at least int
+template<GraphStorage GraphType>
+using DistanceType = typename DistanceTypeOf<GraphType>::type;
+
+template<GraphStorage GraphType>
+using GraphWorkspace = BasicSearchWorkspace<DistanceType<GraphType>>;
+
+// storage, where every pair of vertices is connected, GetAdjacencyRow(from)
+// returns lengths of edges from 'from' to every vertex
+template<typename GraphType>
+concept DenseGraphStorage = GraphStorage<GraphType> &&
+    requires(const GraphType& graph, int vertex) {
+      { graph.GetAdjacencyRow(vertex)[vertex] } -> std::convertible_to<int>;
+    };
+
+// what a search does after visiting a vertex, visitors can also return bool,
+// where false stops the search
+enum class VisitAction {
+  kContinue,
+  // edges of the vertex aren't relaxed, so vertices behind it are reached
+  // only through other vertices
+  kSkipEdges,
+  kStop,
+};
+
+inline VisitAction ToVisitAction(bool continue_search) {
+  return continue_search ? VisitAction::kContinue : VisitAction::kStop;
+}
+inline VisitAction ToVisitAction(VisitAction action) {
+  return action;
+}
+
+// called as visitor(vertex, distance)
+template<typename Visitor, typename Distance = int>
+concept SearchVisitor = std::invocable<Visitor&, int, Distance> &&
+    requires(Visitor& visitor) { ToVisitAction(visitor(0, Distance{0})); };
+
+// 'to_output' converts vertices of the storage into indices of returned edges
+template<std::integral Distance, typename Mapping = std::identity>
+std::vector<AbstractGraph::Edge> RestorePath(
+    const BasicSearchWorkspace<Distance>& tree,
+    int to,
+    Mapping to_output = {}) {
+  assert(0 <= to && to < tree.GetSize());
+
+  std::vector<AbstractGraph::Edge> path;
+
+  for (int i = to; tree.GetAncestor(i) != -1; i = tree.GetAncestor(i)) {
+    path.emplace_back(to_output(i),
+                      static_cast<int>(tree.GetDistance(i) -
+                          tree.GetDistance(tree.GetAncestor(i))));
+  }
+
+  std::reverse(path.begin(), path.end());
+
+  return path;
+}
+
+// Every search below stores its result in 'workspace' (the thread local one
+// if it is nullptr) and returns it, so the result is valid until the next
+// search with the same workspace. Methods of graphs search with
+// GetGraphThreadLocal(), so calling them doesn't invalidate it. Distances
+// are added with saturation, so paths longer than the maximum of the
+// distance type are unreachable instead of overflowing.
+
+// stops as soon as 'to' is reached, explores whole component if 'to' is -1
+template<GraphStorage GraphType>
+const GraphWorkspace<GraphType>& BreadthFirstSearch(
+    const GraphType& graph,
+    int from,
+    int to = -1,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  using Distance = DistanceType<GraphType>;
+  int n = graph.GetSize();
+  assert(0 <= from && from < n);
+
+  GraphWorkspace<GraphType>& tree =
+      workspace ? *workspace : GraphWorkspace<GraphType>::GetThreadLocal();
+  tree.Reset(n);
+  // stores vertices, that will be explored later on
+  std::vector<int>& vertices_queue = tree.GetQueue();
+
+  METRICS_ADD(kBreadthFirstSearchRuns, 1);
+
+  tree.Update(from, 0, -1);
+  vertices_queue.push_back(from);
+
+  for (int head = 0; head < vertices_queue.size(); ++head) {
+    int vertex = vertices_queue[head];
+    Distance vertex_dist = tree.GetDistance(vertex);
+
+    for (const auto& edge : graph.GetEdges(vertex)) {
+      if (!tree.IsReached(edge.to)) {
+        tree.Update(edge.to,
+                    SaturatingAdd<Distance>(vertex_dist, edge.length),
+                    vertex);
+        vertices_queue.push_back(edge.to);
+        if (edge.to == to) {
+          return tree;
+        }
+      }
+    }
+  }
+
+  return tree;
+}
+
+// O(n^2 + m), dense storages are relaxed straight from adjacency rows
+template<GraphStorage GraphType>
+const GraphWorkspace<GraphType>& DijkstraForDense(
+    const GraphType& graph,
+    int from,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  using Distance = DistanceType<GraphType>;
+  int n = graph.GetSize();
+  assert(0 <= from && from < n);
+
+  GraphWorkspace<GraphType>& tree =
+      workspace ? *workspace : GraphWorkspace<GraphType>::GetThreadLocal();
+  tree.Reset(n);
+
+  // stores vertices, that weren't explored yet
+  VertexBitset& unsettled = tree.GetBitset();
+  unsettled.Assign(n, true);
+
+  METRICS_ADD(kDijkstraRuns, 1);
+
+  tree.Update(from, 0, -1);
+
+  int i = 0;
+  for (; i < n; ++i) {
+    int vertex = -1;
+    Distance vertex_dist = kInfDistance<Distance>;
+
+    unsettled.ForEachSetBit([&tree, &vertex, &vertex_dist](int candidate) {
+      Distance candidate_dist = tree.GetDistance(candidate);
+      if (candidate_dist < vertex_dist) {
+        vertex = candidate;
+        vertex_dist = candidate_dist;
+      }
+    });
+
+    if (vertex == -1) {
+      break;
+    }
+
+    unsettled.Reset(vertex);
+
+    auto relax = [&tree, vertex, vertex_dist](int to, Distance length) {
+      Distance to_dist = SaturatingAdd(vertex_dist, length);
+      if (to_dist < tree.GetDistance(to)) {
+        tree.Update(to, to_dist, vertex);
+      }
+    };
+    if constexpr (DenseGraphStorage<GraphType>) {
+      const auto& row = graph.GetAdjacencyRow(vertex);
+      for (int to = 0; to < n; ++to) {
+        relax(to, row[to]);
+      }
+    } else {
+      for (const auto& edge : graph.GetEdges(vertex)) {
+        relax(edge.to, edge.length);
+      }
+    }
+  }
+
+  METRICS_ADD(kSettledVertices, i);
+  return tree;
+}
+
+// O((n + m) log n), calls visitor(vertex, distance) for vertices in order of
+// increasing distance to the closest of 'sources' (ties are broken by smaller
+// index) and acts as it returns. Sources have no ancestor, so the closest
+// source of a vertex is the root of its ancestors chain.
+template<GraphStorage GraphType, typename Visitor>
+  requires SearchVisitor<Visitor, DistanceType<GraphType>>
+const GraphWorkspace<GraphType>& MultiSourceDijkstra(
+    const GraphType& graph,
+    std::span<const int> sources,
+    Visitor visitor,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  using Distance = DistanceType<GraphType>;
+  int n = graph.GetSize();
+
+  GraphWorkspace<GraphType>& tree =
+      workspace ? *workspace : GraphWorkspace<GraphType>::GetThreadLocal();
+  tree.Reset(n);
+  // stores vertices, that will be explored later on, as a binary heap
+  std::vector<std::pair<Distance, int>>& vertices_queue = tree.GetHeap();
+
+  // counted locally and added once, so the loop doesn't touch metrics, the
+  // counters are optimized out when metrics are disabled
+  [[maybe_unused]] uint64_t settled_count = 0;
+  [[maybe_unused]] uint64_t pushes_count = 0;
+
+  for (int source : sources) {
+    assert(0 <= source && source < n);
+    if (tree.IsReached(source)) {
+      continue;
+    }
+    tree.Update(source, 0, -1);
+    vertices_queue.emplace_back(0, source);
+    ++pushes_count;
+  }
+  std::make_heap(vertices_queue.begin(), vertices_queue.end(),
+                 std::greater<>());
+
+  while (!vertices_queue.empty()) {
+    std::pop_heap(vertices_queue.begin(), vertices_queue.end(),
+                  std::greater<>());
+    auto[vertex_dist, vertex] = vertices_queue.back();
+    vertices_queue.pop_back();
+
+    // vertex was already explored with smaller distance
+    if (vertex_dist != tree.GetDistance(vertex)) {
+      continue;
+    }
+
+    VisitAction action = ToVisitAction(visitor(vertex, vertex_dist));
+    if (action == VisitAction::kStop) {
+      break;
+    }
+    ++settled_count;
+    if (action == VisitAction::kSkipEdges) {
+      continue;
+    }
+
+    for (const auto& edge : graph.GetEdges(vertex)) {
+      Distance to_dist = SaturatingAdd<Distance>(vertex_dist, edge.length);
+      if (to_dist < tree.GetDistance(edge.to)) {
+        tree.Update(edge.to, to_dist, vertex);
+        vertices_queue.emplace_back(to_dist, edge.to);
+        std::push_heap(vertices_queue.begin(), vertices_queue.end(),
+                       std::greater<>());
+        ++pushes_count;
+      }
+    }
+  }
+
+  METRICS_ADD(kDijkstraRuns, 1);
+  METRICS_ADD(kSettledVertices, settled_count);
+  METRICS_ADD(kHeapPushes, pushes_count);
+  return tree;
+}
+
+// single source version of MultiSourceDijkstra
+template<GraphStorage GraphType, typename Visitor>
+  requires SearchVisitor<Visitor, DistanceType<GraphType>>
+const GraphWorkspace<GraphType>& DijkstraForSparse(
+    const GraphType& graph,
+    int from,
+    Visitor visitor,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  return MultiSourceDijkstra(
+      graph, std::span(&from, 1), std::move(visitor), workspace);
+}
+
+template<GraphStorage GraphType>
+const GraphWorkspace<GraphType>& DijkstraForSparse(
+    const GraphType& graph,
+    int from,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  return DijkstraForSparse(
+      graph, from, [](int, DistanceType<GraphType>) { return true; },
+      workspace);
+}
+
+// nearest-vehicle style search: visits vertices in order of increasing
+// distance from 'from' while visitor(vertex, distance) returns true
+template<GraphStorage GraphType, typename Visitor>
+  requires std::predicate<Visitor, int, DistanceType<GraphType>>
+void VisitClosestVertices(const GraphType& graph,
+                          int from,
+                          Visitor visitor,
+                          GraphWorkspace<GraphType>* workspace = nullptr) {
+  DijkstraForSparse(graph, from, std::move(visitor), workspace);
+}
+
+// A* search from 'from': vertices are visited in order of distance plus
+// potential(vertex), which is a lower bound on the distance from the vertex
+// to the goals and must be consistent, i.e. potential(vertex) is at most
+// edge length plus potential(edge.to) for every edge. Distances of visited
+// vertices are final, so goals (vertices with zero potential) are visited in
+// order of increasing distance. Vertices with potential kInfDistance can't
+// reach goals and are never visited.
+template<GraphStorage GraphType, typename Potential, typename Visitor>
+  requires SearchVisitor<Visitor, DistanceType<GraphType>> &&
+      std::invocable<Potential&, int>
+const GraphWorkspace<GraphType>& GoalDirectedSearch(
+    const GraphType& graph,
+    int from,
+    Potential potential,
+    Visitor visitor,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  using Distance = DistanceType<GraphType>;
+  int n = graph.GetSize();
+  assert(0 <= from && from < n);
+
+  GraphWorkspace<GraphType>& tree =
+      workspace ? *workspace : GraphWorkspace<GraphType>::GetThreadLocal();
+  tree.Reset(n);
+  // (distance plus potential, vertex)
+  std::vector<std::pair<Distance, int>>& vertices_queue = tree.GetHeap();
+
+  [[maybe_unused]] uint64_t settled_count = 0;
+  [[maybe_unused]] uint64_t pushes_count = 0;
+
+  tree.Update(from, 0, -1);
+  Distance from_potential = potential(from);
+  if (from_potential != kInfDistance<Distance>) {
+    vertices_queue.emplace_back(from_potential, from);
+    ++pushes_count;
+  }
+
+  while (!vertices_queue.empty()) {
+    std::pop_heap(vertices_queue.begin(), vertices_queue.end(),
+                  std::greater<>());
+    auto[vertex_key, vertex] = vertices_queue.back();
+    vertices_queue.pop_back();
+
+    // potential is computed again instead of being stored in the heap
+    Distance vertex_dist = tree.GetDistance(vertex);
+    if (vertex_key != SaturatingAdd<Distance>(vertex_dist, potential(vertex))) {
+      continue;
+    }
+
+    VisitAction action = ToVisitAction(visitor(vertex, vertex_dist));
+    if (action == VisitAction::kStop) {
+      break;
+    }
+    ++settled_count;
+    if (action == VisitAction::kSkipEdges) {
+      continue;
+    }
+
+    for (const auto& edge : graph.GetEdges(vertex)) {
+      Distance to_dist = SaturatingAdd<Distance>(vertex_dist, edge.length);
+      if (to_dist < tree.GetDistance(edge.to)) {
+        Distance to_potential = potential(edge.to);
+        if (to_potential == kInfDistance<Distance>) {
+          continue;
+        }
+        tree.Update(edge.to, to_dist, vertex);
+        vertices_queue.emplace_back(
+            SaturatingAdd<Distance>(to_dist, to_potential), edge.to);
+        std::push_heap(vertices_queue.begin(), vertices_queue.end(),
+                       std::greater<>());
+        ++pushes_count;
+      }
+    }
+  }
+
+  METRICS_ADD(kDijkstraRuns, 1);
+  METRICS_ADD(kSettledVertices, settled_count);
+  METRICS_ADD(kHeapPushes, pushes_count);
+  return tree;
+}
+
+// picks Dijkstra implementation suitable for the storage at compile time
+template<GraphStorage GraphType>
+const GraphWorkspace<GraphType>& Dijkstra(
+    const GraphType& graph,
+    int from,
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  if constexpr (DenseGraphStorage<GraphType>) {
+    return DijkstraForDense(graph, from, workspace);
+  } else {
+    return DijkstraForSparse(graph, from, workspace);
+  }
+}
+
+}  // namespace algorithms
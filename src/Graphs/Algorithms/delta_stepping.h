@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "../../Executor/executor.h"
+#include "algorithms.h"
+
+namespace algorithms {
+
+struct DeltaSteppingOptions {
+  // upper bound on the number of threads, 0 means all threads of the executor
+  // and the calling one
+  int threads_count{0};
+  // width of distance buckets, 0 means it's estimated from the graph; it's
+  // raised, when the longest edge would span more than kMaxBucketsCount
+  // buckets
+  int delta{0};
+  // nullptr means executor::GetDefaultExecutor()
+  executor::Executor* executor{nullptr};
+};
+
+namespace delta_stepping_details {
+
+// buckets are cyclic, vertices waiting for relaxation are within the
+// longest edge from the current bucket
+const int kMaxBucketsCount = 4096;
+
+// distance and ancestor of a vertex are updated by one atomic operation, so
+// the ancestor always matches the distance
+inline uint64_t Pack(int distance, int ancestor) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(distance)) << 32) |
+      static_cast<uint32_t>(ancestor + 1);
+}
+inline int GetDistance(uint64_t state) {
+  return static_cast<int>(state >> 32);
+}
+inline int GetAncestor(uint64_t state) {
+  return static_cast<int>(static_cast<uint32_t>(state)) - 1;
+}
+
+// Width, for which vertices of a bucket are rarely relaxed again (Meyer and
+// Sanders): the greatest edge length divided by the average degree. Both are
+// taken from a sample of vertices, so the estimate costs much less than the
+// search.
+template<GraphStorage GraphType>
+int EstimateDelta(const GraphType& graph) {
+  const int kSamplesCount = 1024;
+  int n = graph.GetSize();
+  int samples_count = std::min(n, kSamplesCount);
+  int64_t edges_count = 0;
+  int max_length = 0;
+  for (int i = 0; i < samples_count; ++i) {
+    for (const auto& edge : graph.GetEdges(
+        static_cast<int>(int64_t{i} * n / samples_count))) {
+      ++edges_count;
+      max_length = std::max<int>(max_length, edge.length);
+    }
+  }
+  if (edges_count == 0) {
+    return 1;
+  }
+  return std::max<int64_t>(1, int64_t{max_length} * samples_count /
+      edges_count);
+}
+
+}  // namespace delta_stepping_details
+
+// Parallel single source shortest paths for large sparse graphs with int
+// distances, results are the same as of Dijkstra: equal distances, ancestors
+// form a tree of shortest paths (it's the same, when shortest paths are
+// unique).
+// Vertices are kept in buckets of 'delta' width of distance. Vertices of the
+// smallest non-empty bucket are processed in parallel, their light edges (not
+// longer than 'delta') are relaxed until the bucket stays empty, then heavy
+// edges of all vertices removed from it are relaxed, they can only reach
+// later buckets. Every slot of executor::ParallelFor keeps its own buckets,
+// so they are written without locks, distances are updated by
+// compare-and-swap. Buckets are reused cyclically, there are as many of them
+// as the longest edge spans, so memory doesn't depend on distances.
+template<GraphStorage GraphType>
+const GraphWorkspace<GraphType>& DeltaStepping(
+    const GraphType& graph,
+    int from,
+    DeltaSteppingOptions options = {},
+    GraphWorkspace<GraphType>* workspace = nullptr) {
+  static_assert(std::is_same_v<DistanceType<GraphType>, int>,
+                "distance and ancestor are packed into 64 bits");
+  using delta_stepping_details::Pack;
+  using delta_stepping_details::GetDistance;
+  using delta_stepping_details::GetAncestor;
+
+  int n = graph.GetSize();
+  assert(0 <= from && from < n);
+
+  GraphWorkspace<GraphType>& tree =
+      workspace ? *workspace : GraphWorkspace<GraphType>::GetThreadLocal();
+  tree.Reset(n);
+
+  executor::Executor& executor = options.executor
+      ? *options.executor
+      : executor::GetDefaultExecutor();
+  int slots_count = executor::GetSlotsCount(executor);
+  if (options.threads_count > 0) {
+    slots_count = std::min(slots_count, options.threads_count);
+  }
+
+  METRICS_ADD(kDeltaSteppingRuns, 1);
+
+  struct SlotState {
+    std::vector<std::vector<int>> buckets;
+    // vertices of the current bucket, which are relaxed in this round
+    std::vector<int> frontier;
+    // vertices removed from the current bucket, for heavy edges
+    std::vector<int> settled;
+  };
+  std::vector<SlotState> slot_states(slots_count);
+  std::vector<std::atomic<uint64_t>> states(n);
+  // round, in which vertex was relaxed last, so it's relaxed once per round
+  std::vector<std::atomic<uint32_t>> rounds(n);
+  const size_t kChunkSize = 64;
+  const size_t kStripeSize = 4096;
+
+  int delta = 1;
+  size_t buckets_count = 1;
+  auto relax = [&](SlotState* own, int vertex, int to, int to_dist) {
+    uint64_t state = states[to].load(std::memory_order_relaxed);
+    while (to_dist < GetDistance(state)) {
+      if (states[to].compare_exchange_weak(state, Pack(to_dist, vertex),
+                                           std::memory_order_relaxed)) {
+        own->buckets[static_cast<size_t>(to_dist / delta) % buckets_count]
+            .push_back(to);
+        return;
+      }
+    }
+  };
+
+  // lists of all slots form one range of vertices, which is split between
+  // slots again; returns the number of vertices
+  std::vector<size_t> offsets(slots_count + 1, 0);
+  auto for_each_listed = [&](std::vector<int> SlotState::* list,
+                             const auto& process) {
+    for (int i = 0; i < slots_count; ++i) {
+      offsets[i + 1] = offsets[i] + (slot_states[i].*list).size();
+    }
+    executor::ParallelFor(
+        executor, 0, offsets[slots_count], kChunkSize,
+        [&](int slot, size_t begin, size_t end) {
+          int owner = std::upper_bound(offsets.begin(), offsets.end(),
+                                       begin) - offsets.begin() - 1;
+          for (size_t i = begin; i < end; ++i) {
+            while (i >= offsets[owner + 1]) {
+              ++owner;
+            }
+            process(&slot_states[slot],
+                    (slot_states[owner].*list)[i - offsets[owner]]);
+          }
+        },
+        slots_count);
+    return offsets[slots_count];
+  };
+
+  // the longest edge is found exactly, a sample could miss it
+  std::vector<int> max_lengths(slots_count, 0);
+  executor::ParallelFor(
+      executor, 0, n, kStripeSize,
+      [&](int slot, size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+          states[vertex].store(Pack(kInf, -1), std::memory_order_relaxed);
+          rounds[vertex].store(0, std::memory_order_relaxed);
+          for (const auto& edge : graph.GetEdges(vertex)) {
+            max_lengths[slot] = std::max<int>(max_lengths[slot], edge.length);
+          }
+        }
+      },
+      slots_count);
+  int max_length = *std::max_element(max_lengths.begin(), max_lengths.end());
+  delta = options.delta > 0 ? options.delta
+                            : delta_stepping_details::EstimateDelta(graph);
+  delta = std::max<int64_t>(
+      delta, (int64_t{max_length} + delta_stepping_details::kMaxBucketsCount -
+              2) / (delta_stepping_details::kMaxBucketsCount - 1));
+  // tentative distances are less than the end of the current bucket plus
+  // the longest edge
+  buckets_count = max_length / delta + 2;
+  for (auto& slot_state : slot_states) {
+    slot_state.buckets.resize(buckets_count);
+  }
+  states[from].store(Pack(0, -1), std::memory_order_relaxed);
+  slot_states[0].buckets[0].push_back(from);
+
+  size_t current_bucket = 0;
+  uint32_t round = 0;
+  while (true) {
+    // light edges, until the bucket stays empty
+    while (true) {
+      for (auto& slot_state : slot_states) {
+        slot_state.frontier.clear();
+        std::swap(slot_state.frontier,
+                  slot_state.buckets[current_bucket % buckets_count]);
+      }
+      ++round;
+      size_t frontier_size = for_each_listed(
+          &SlotState::frontier, [&](SlotState* own, int vertex) {
+            int vertex_dist =
+                GetDistance(states[vertex].load(std::memory_order_relaxed));
+            // vertex was moved to another bucket or was already relaxed
+            if (static_cast<size_t>(vertex_dist / delta) != current_bucket ||
+                rounds[vertex].exchange(round) == round) {
+              return;
+            }
+            own->settled.push_back(vertex);
+            for (const auto& edge : graph.GetEdges(vertex)) {
+              if (edge.length <= delta) {
+                relax(own, vertex, edge.to,
+                      SaturatingAdd<int>(vertex_dist, edge.length));
+              }
+            }
+          });
+      if (frontier_size == 0) {
+        break;
+      }
+    }
+
+    for_each_listed(&SlotState::settled, [&](SlotState* own, int vertex) {
+      int vertex_dist =
+          GetDistance(states[vertex].load(std::memory_order_relaxed));
+      for (const auto& edge : graph.GetEdges(vertex)) {
+        if (edge.length > delta) {
+          relax(own, vertex, edge.to,
+                SaturatingAdd<int>(vertex_dist, edge.length));
+        }
+      }
+    });
+    for (auto& slot_state : slot_states) {
+      slot_state.settled.clear();
+    }
+
+    size_t next_bucket = SIZE_MAX;
+    for (const auto& slot_state : slot_states) {
+      for (size_t bucket = current_bucket + 1;
+           bucket < std::min(next_bucket, current_bucket + buckets_count);
+           ++bucket) {
+        if (!slot_state.buckets[bucket % buckets_count].empty()) {
+          next_bucket = bucket;
+          break;
+        }
+      }
+    }
+    if (next_bucket == SIZE_MAX) {
+      break;
+    }
+    current_bucket = next_bucket;
+  }
+
+  executor::ParallelFor(
+      executor, 0, n, kStripeSize,
+      [&](int, size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+          uint64_t state = states[vertex].load(std::memory_order_relaxed);
+          if (GetDistance(state) != kInf) {
+            tree.Update(vertex, GetDistance(state), GetAncestor(state));
+          }
+        }
+      },
+      slots_count);
+
+  return tree;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace algorithms {
+
+// Values with O(log n) updates and sums of ranges, e.g. counts by preorder
+// index, where every subtree is a range.
+class FenwickTree {
+ public:
+  FenwickTree() = default;
+
+  // 'size' zero values
+  void Assign(int size) {
+    sums_.assign(size + 1, 0);
+  }
+
+  int GetSize() const {
+    return sums_.empty() ? 0 : sums_.size() - 1;
+  }
+
+  void Add(int index, int64_t delta) {
+    assert(0 <= index && index < GetSize());
+    for (int i = index + 1; i < sums_.size(); i += i & -i) {
+      sums_[i] += delta;
+    }
+  }
+
+  // sum of [begin, end)
+  int64_t GetSum(int begin, int end) const {
+    assert(0 <= begin && begin <= end && end <= GetSize());
+    return GetPrefixSum(end) - GetPrefixSum(begin);
+  }
+
+ private:
+  int64_t GetPrefixSum(int end) const {
+    int64_t sum = 0;
+    for (int i = end; i > 0; i -= i & -i) {
+      sum += sums_[i];
+    }
+    return sum;
+  }
+
+  // sums_[i] is the sum of (i - (i & -i), i] of 1-based indices
+  std::vector<int64_t> sums_;
+};
+
+}  // namespace algorithms
@@ -0,0 +1,71 @@
+#include "hub_labels.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace algorithms {
+
+int HubLabels::GetDistance(int from, int to) const {
+  assert(0 <= from && from < GetSize());
+  assert(0 <= to && to < GetSize());
+  const int* lhs_hubs = hubs_.data() + offsets_[from];
+  const int* lhs_distances = distances_.data() + offsets_[from];
+  size_t lhs_size = offsets_[from + 1] - offsets_[from];
+  const int* rhs_hubs = hubs_.data() + offsets_[to];
+  const int* rhs_distances = distances_.data() + offsets_[to];
+  size_t rhs_size = offsets_[to + 1] - offsets_[to];
+
+  int64_t result = kInf;
+  size_t i = 0;
+  size_t j = 0;
+#if defined(__SSE2__)
+  // Blocks of four hubs are compared with all rotations of each other at
+  // once. Common hubs are rare, so most blocks are skipped after a single
+  // comparison, and the block with the smaller last hub is the next one.
+  while (i + 4 <= lhs_size && j + 4 <= rhs_size) {
+    __m128i lhs = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(lhs_hubs + i));
+    __m128i rhs = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(rhs_hubs + j));
+    __m128i equal = _mm_or_si128(
+        _mm_or_si128(
+            _mm_cmpeq_epi32(lhs, rhs),
+            _mm_cmpeq_epi32(lhs,
+                            _mm_shuffle_epi32(rhs, _MM_SHUFFLE(0, 3, 2, 1)))),
+        _mm_or_si128(
+            _mm_cmpeq_epi32(lhs,
+                            _mm_shuffle_epi32(rhs, _MM_SHUFFLE(1, 0, 3, 2))),
+            _mm_cmpeq_epi32(lhs,
+                            _mm_shuffle_epi32(rhs, _MM_SHUFFLE(2, 1, 0, 3)))));
+    if (_mm_movemask_epi8(equal) != 0) {
+      for (size_t k = i; k < i + 4; ++k) {
+        for (size_t l = j; l < j + 4; ++l) {
+          if (lhs_hubs[k] == rhs_hubs[l]) {
+            result = std::min(
+                result, int64_t{lhs_distances[k]} + rhs_distances[l]);
+          }
+        }
+      }
+    }
+    int lhs_last = lhs_hubs[i + 3];
+    int rhs_last = rhs_hubs[j + 3];
+    i += lhs_last <= rhs_last ? 4 : 0;
+    j += rhs_last <= lhs_last ? 4 : 0;
+  }
+#endif
+  while (i < lhs_size && j < rhs_size) {
+    if (lhs_hubs[i] == rhs_hubs[j]) {
+      result = std::min(result, int64_t{lhs_distances[i]} + rhs_distances[j]);
+      ++i;
+      ++j;
+    } else if (lhs_hubs[i] < rhs_hubs[j]) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  return std::min<int64_t>(result, kInf);
+}
+
+}  // namespace algorithms
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../Executor/executor.h"
+#include "algorithms.h"
+
+namespace algorithms {
+
+// Distance oracle of a graph with symmetric edges: every vertex has a label
+// of (hub, distance) pairs, so that every shortest path passes through a hub
+// common to the labels of its ends, and a query is a merge of two sorted
+// labels instead of a search.
+// Labels are built by pruned landmark labeling (Akiba, Iwata and Yoshida):
+// vertices are taken from the most important ones, Dijkstra from a vertex
+// doesn't go beyond vertices, which distances are already answered by labels
+// of more important ones. Importance is the number of vertices below the
+// vertex in shortest path trees of a few random roots, so hubs are vertices
+// many shortest paths go through, e.g. highways of road graphs, and labels
+// stay short.
+class HubLabels {
+ public:
+  HubLabels() = default;
+
+  // Searches run in parallel on 'executor', nullptr means
+  // executor::GetDefaultExecutor(). Labels are built from batches of a root
+  // per slot of executor::ParallelFor, searches of a batch are pruned only
+  // by labels of previous batches, so labels grow with the number of slots,
+  // e.g. by a quarter with 8 slots on a grid; with one slot they are the
+  // sequential ones. A grid of 100k vertices takes about 30 s on one thread.
+  template<GraphStorage GraphType>
+  static HubLabels Build(const GraphType& graph,
+                         executor::Executor* executor = nullptr);
+
+  // number of vertices
+  int GetSize() const {
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+  }
+  // total size of labels, they take 8 bytes per pair
+  int64_t GetLabelsSize() const {
+    return hubs_.size();
+  }
+
+  // kInf if 'to' isn't reachable from 'from'
+  int GetDistance(int from, int to) const;
+
+ private:
+  // label of 'vertex' is [offsets_[vertex], offsets_[vertex + 1]) of
+  // 'hubs_' and 'distances_'; hubs are ranks of vertices by importance, so
+  // they are sorted in order, in which labels are built
+  std::vector<int64_t> offsets_;
+  std::vector<int> hubs_;
+  std::vector<int> distances_;
+};
+
+template<GraphStorage GraphType>
+HubLabels HubLabels::Build(const GraphType& graph,
+                           executor::Executor* executor) {
+  static_assert(std::is_same_v<DistanceType<GraphType>, int>,
+                "hub distances are int");
+  int n = graph.GetSize();
+  HubLabels result;
+  result.offsets_.assign(n + 1, 0);
+  if (n == 0) {
+    return result;
+  }
+  executor::Executor& pool =
+      executor ? *executor : executor::GetDefaultExecutor();
+  int slots_count = executor::GetSlotsCount(pool);
+  // every slot searches with its own workspace, 'vertices' is per slot
+  // scratch of n values
+  struct SlotState {
+    SearchWorkspace tree;
+    std::vector<int> vertices;
+  };
+  std::vector<SlotState> slot_states(slots_count);
+  for (auto& slot_state : slot_states) {
+    slot_state.vertices.resize(n);
+  }
+
+  // Vertices are ranked in rounds, every round ranks as many vertices as
+  // all previous ones, so there are O(log n) rounds. Importance is counted
+  // in trees, which don't go through ranked vertices, so it's about paths
+  // not covered yet, e.g. quarters of a chain after its middle. Vertices
+  // not reached in a round keep their order from previous rounds.
+  const int kRootsCount = 16;
+  std::vector<int64_t> importance(n, 0);
+  std::vector<int64_t> round_importance(n, 0);
+  std::vector<bool> is_ranked(n, false);
+  std::vector<int> order;
+  order.reserve(n);
+  std::vector<int> unranked(n);
+  std::iota(unranked.begin(), unranked.end(), 0);
+  std::mt19937 gen(n);
+  // (vertex, size of its subtree) for every tree of a round
+  std::vector<std::vector<std::pair<int, int>>> subtrees(kRootsCount);
+  std::vector<int> roots(kRootsCount);
+  while (!unranked.empty()) {
+    std::uniform_int_distribution<int> random_index(0, unranked.size() - 1);
+    for (int& root : roots) {
+      root = unranked[random_index(gen)];
+    }
+    executor::ParallelFor(
+        pool, 0, kRootsCount, 1, [&](int slot, size_t begin, size_t end) {
+          auto& [tree, subtree_sizes] = slot_states[slot];
+          for (size_t i = begin; i < end; ++i) {
+            auto& visited = subtrees[i];
+            visited.clear();
+            DijkstraForSparse(graph, roots[i], [&](int vertex, int) {
+              if (is_ranked[vertex]) {
+                return VisitAction::kSkipEdges;
+              }
+              visited.emplace_back(vertex, 0);
+              subtree_sizes[vertex] = 1;
+              return VisitAction::kContinue;
+            }, &tree);
+            for (auto it = visited.rbegin(); it != visited.rend(); ++it) {
+              it->second = subtree_sizes[it->first];
+              int ancestor = tree.GetAncestor(it->first);
+              if (ancestor != -1) {
+                subtree_sizes[ancestor] += it->second;
+              }
+            }
+          }
+        });
+    for (const auto& visited : subtrees) {
+      for (const auto& [vertex, subtree_size] : visited) {
+        round_importance[vertex] += subtree_size;
+      }
+    }
+
+    auto round_end = unranked.begin() +
+        std::min(unranked.size(), std::max<size_t>(1, order.size()));
+    std::partial_sort(unranked.begin(), round_end, unranked.end(),
+                      [&](int lhs, int rhs) {
+                        return std::tie(round_importance[lhs],
+                                        importance[lhs], rhs) >
+                            std::tie(round_importance[rhs],
+                                     importance[rhs], lhs);
+                      });
+    for (auto it = unranked.begin(); it != round_end; ++it) {
+      is_ranked[*it] = true;
+      order.push_back(*it);
+    }
+    unranked.erase(unranked.begin(), round_end);
+    for (int vertex : unranked) {
+      if (round_importance[vertex] > 0) {
+        importance[vertex] = round_importance[vertex];
+        round_importance[vertex] = 0;
+      }
+    }
+  }
+
+  struct LabelEntry {
+    int hub;
+    int distance;
+  };
+  std::vector<std::vector<LabelEntry>> labels(n);
+  for (auto& slot_state : slot_states) {
+    slot_state.vertices.assign(n, kInf);
+  }
+  // the most important roots prune the most, so the first batches are
+  // small, later ones have a root for every slot
+  const int kBatchDivisor = 16;
+  // (vertex, distance) reached from every root of the batch
+  std::vector<std::vector<std::pair<int, int>>> reached;
+  for (int batch_begin = 0; batch_begin < n;) {
+    int batch_end = std::min(
+        n, batch_begin + std::clamp(batch_begin / kBatchDivisor, 1,
+                                    slots_count));
+    reached.resize(batch_end - batch_begin);
+    executor::ParallelFor(
+        pool, batch_begin, batch_end, 1,
+        [&](int slot, size_t begin, size_t end) {
+          // label of the current root by hub, kInf for other hubs
+          auto& [tree, root_distances] = slot_states[slot];
+          for (size_t rank = begin; rank < end; ++rank) {
+            int root = order[rank];
+            auto& root_reached = reached[rank - batch_begin];
+            root_reached.clear();
+            for (const auto& [hub, distance] : labels[root]) {
+              root_distances[hub] = distance;
+            }
+            root_distances[rank] = 0;
+            DijkstraForSparse(graph, root, [&](int vertex, int distance) {
+              for (const auto& [hub, hub_distance] : labels[vertex]) {
+                if (root_distances[hub] != kInf &&
+                    int64_t{root_distances[hub]} + hub_distance <=
+                        distance) {
+                  return VisitAction::kSkipEdges;
+                }
+              }
+              root_reached.emplace_back(vertex, distance);
+              return VisitAction::kContinue;
+            }, &tree);
+            for (const auto& [hub, distance] : labels[root]) {
+              root_distances[hub] = kInf;
+            }
+            root_distances[rank] = kInf;
+          }
+        });
+    // labels are appended in order of ranks, so they stay sorted by hub
+    for (int rank = batch_begin; rank < batch_end; ++rank) {
+      for (const auto& [vertex, distance] : reached[rank - batch_begin]) {
+        labels[vertex].push_back({rank, distance});
+      }
+    }
+    batch_begin = batch_end;
+  }
+
+  for (int vertex = 0; vertex < n; ++vertex) {
+    result.offsets_[vertex + 1] =
+        result.offsets_[vertex] + labels[vertex].size();
+  }
+  result.hubs_.reserve(result.offsets_[n]);
+  result.distances_.reserve(result.offsets_[n]);
+  for (auto& label : labels) {
+    for (const auto& [hub, distance] : label) {
+      result.hubs_.push_back(hub);
+      result.distances_.push_back(distance);
+    }
+    // memory of labels is returned as soon as they are copied
+    std::vector<LabelEntry>().swap(label);
+  }
+  return result;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,57 @@
+#include "landmarks.h"
+
+#include <string>
+
+namespace algorithms {
+
+namespace {
+
+const char* kLandmarksHeader = "Landmarks";
+
+}  // namespace
+
+void Landmarks::Write(std::ostream& output) const {
+  output << kLandmarksHeader << ' ' << size_ << ' ' << GetCount() << '\n';
+  for (int i = 0; i < GetCount(); ++i) {
+    output << (i == 0 ? "" : " ") << landmarks_[i];
+  }
+  output << '\n';
+  for (int vertex = 0; vertex < size_; ++vertex) {
+    auto distances = GetDistances(vertex);
+    for (int i = 0; i < distances.size(); ++i) {
+      output << (i == 0 ? "" : " ")
+             << (distances[i] == kInf ? -1 : distances[i]);
+    }
+    output << '\n';
+  }
+}
+
+std::optional<Landmarks> Landmarks::Read(std::istream& input) {
+  std::string header;
+  int size;
+  int count;
+  if (!(input >> header >> size >> count) || header != kLandmarksHeader ||
+      size < 0 || count < 0 || (size == 0 && count > 0)) {
+    return std::nullopt;
+  }
+  Landmarks result;
+  result.size_ = size;
+  result.landmarks_.resize(count);
+  for (int& landmark : result.landmarks_) {
+    if (!(input >> landmark) || landmark < 0 || landmark >= size) {
+      return std::nullopt;
+    }
+  }
+  result.distances_.resize(static_cast<size_t>(size) * count);
+  for (int& distance : result.distances_) {
+    if (!(input >> distance) || distance < -1) {
+      return std::nullopt;
+    }
+    if (distance == -1) {
+      distance = kInf;
+    }
+  }
+  return result;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <istream>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "../../Executor/executor.h"
+#include "algorithms.h"
+#include "delta_stepping.h"
+
+namespace algorithms {
+
+enum class LandmarkSelection {
+  // every next landmark is the vertex farthest from the chosen ones
+  kFarthest,
+  // every next landmark is a leaf of the shortest path tree of a random
+  // vertex, which is behind most vertices with weak bounds (Goldberg and
+  // Werneck)
+  kAvoid,
+};
+
+// Distances from a few landmark vertices to every vertex of a graph with
+// symmetric edges. By triangle inequality |d(l, u) - d(l, v)| <= d(u, v) for
+// every landmark l, which gives lower bounds for goal directed search (ALT).
+// Distances of a vertex to all landmarks are stored together, so a bound
+// reads two rows.
+class Landmarks {
+ public:
+  Landmarks() = default;
+
+  // Searches run in parallel on 'executor', nullptr means
+  // executor::GetDefaultExecutor(). There are fewer than 'count' landmarks,
+  // when the graph is too small to have more useful ones.
+  template<GraphStorage GraphType>
+  static Landmarks Build(const GraphType& graph,
+                         int count,
+                         LandmarkSelection selection =
+                             LandmarkSelection::kAvoid,
+                         executor::Executor* executor = nullptr);
+
+  bool operator==(const Landmarks& rhs) const = default;
+
+  // number of vertices
+  int GetSize() const {
+    return size_;
+  }
+  int GetCount() const {
+    return landmarks_.size();
+  }
+  const std::vector<int>& GetLandmarks() const {
+    return landmarks_;
+  }
+  // distances from every landmark to 'vertex', kInf if it's not reachable
+  std::span<const int> GetDistances(int vertex) const {
+    assert(0 <= vertex && vertex < size_);
+    return {distances_.data() + vertex * landmarks_.size(),
+            landmarks_.size()};
+  }
+
+  // kInf if vertices are in different components
+  int GetLowerBound(int from, int to) const {
+    auto from_distances = GetDistances(from);
+    auto to_distances = GetDistances(to);
+    int bound = 0;
+    for (int i = 0; i < from_distances.size(); ++i) {
+      if ((from_distances[i] == kInf) != (to_distances[i] == kInf)) {
+        return kInf;
+      }
+      if (from_distances[i] != kInf) {
+        bound = std::max(bound,
+                         std::abs(from_distances[i] - to_distances[i]));
+      }
+    }
+    return bound;
+  }
+
+  // Text format: "Landmarks <vertices count> <landmarks count>" line, the
+  // line of landmarks, then a line of distances for every vertex, where
+  // unreachable ones are -1.
+  void Write(std::ostream& output) const;
+  // std::nullopt if input is malformed
+  static std::optional<Landmarks> Read(std::istream& input);
+
+ private:
+  int size_{0};
+  std::vector<int> landmarks_;
+  // distances_[vertex * landmarks_.size() + landmark_index]
+  std::vector<int> distances_;
+};
+
+// Lower bound on the distance from a vertex to the closest of 'goals', for
+// GoalDirectedSearch. It's the greatest over landmarks distance from the
+// landmark distance of the vertex to the closest landmark distance of a goal,
+// which is found by binary search, so goals can be many.
+class LandmarksPotential {
+ public:
+  LandmarksPotential(const Landmarks& landmarks, std::span<const int> goals)
+      : landmarks_(landmarks),
+        goal_distances_(landmarks.GetCount()),
+        has_unreachable_goals_(landmarks.GetCount(), false) {
+    for (int goal : goals) {
+      auto distances = landmarks_.GetDistances(goal);
+      for (int i = 0; i < distances.size(); ++i) {
+        if (distances[i] == kInf) {
+          has_unreachable_goals_[i] = true;
+        } else {
+          goal_distances_[i].push_back(distances[i]);
+        }
+      }
+    }
+    for (auto& distances : goal_distances_) {
+      std::sort(distances.begin(), distances.end());
+    }
+  }
+
+  int operator()(int vertex) const {
+    auto distances = landmarks_.GetDistances(vertex);
+    int bound = 0;
+    for (int i = 0; i < distances.size(); ++i) {
+      // goals, which are not reachable from the landmark, may be in the
+      // component of the vertex
+      if (distances[i] == kInf) {
+        if (!has_unreachable_goals_[i]) {
+          return kInf;
+        }
+        continue;
+      }
+      // the vertex is reachable, and goals aren't
+      const auto& goal_distances = goal_distances_[i];
+      if (goal_distances.empty()) {
+        return kInf;
+      }
+      auto next = std::lower_bound(goal_distances.begin(),
+                                   goal_distances.end(), distances[i]);
+      int closest = kInf;
+      if (next != goal_distances.end()) {
+        closest = *next - distances[i];
+      }
+      if (next != goal_distances.begin()) {
+        closest = std::min(closest, distances[i] - *std::prev(next));
+      }
+      bound = std::max(bound, closest);
+    }
+    return bound;
+  }
+
+ private:
+  const Landmarks& landmarks_;
+  // landmark distances of reachable goals for every landmark, sorted
+  std::vector<std::vector<int>> goal_distances_;
+  std::vector<bool> has_unreachable_goals_;
+};
+
+template<GraphStorage GraphType>
+Landmarks Landmarks::Build(const GraphType& graph,
+                           int count,
+                           LandmarkSelection selection,
+                           executor::Executor* executor) {
+  static_assert(std::is_same_v<DistanceType<GraphType>, int>,
+                "landmark distances are int");
+  int n = graph.GetSize();
+  assert(count >= 0);
+  Landmarks result;
+  result.size_ = n;
+  if (n == 0) {
+    return result;
+  }
+  executor::Executor& pool =
+      executor ? *executor : executor::GetDefaultExecutor();
+  const size_t kChunkSize = 4096;
+
+  SearchWorkspace tree;
+  auto search = [&](int from) -> const SearchWorkspace& {
+    return DeltaStepping(graph, from, {0, 0, &pool}, &tree);
+  };
+  // distances from every landmark, landmark-major while they are chosen
+  std::vector<std::vector<int>> columns;
+  // distances to the closest landmark
+  std::vector<int> closest_dist(n, kInf);
+  auto add_landmark = [&](int landmark) {
+    result.landmarks_.push_back(landmark);
+    const SearchWorkspace& landmark_tree = search(landmark);
+    auto& column = columns.emplace_back(n);
+    executor::ParallelFor(
+        pool, 0, n, kChunkSize, [&](int, size_t begin, size_t end) {
+          for (size_t vertex = begin; vertex < end; ++vertex) {
+            column[vertex] = landmark_tree.GetDistance(vertex);
+            closest_dist[vertex] =
+                std::min(closest_dist[vertex], column[vertex]);
+          }
+        });
+  };
+  // the farthest vertex from chosen landmarks, vertices, which they don't
+  // reach, are the farthest ones, so every component gets a landmark; the
+  // farthest vertex from vertex 0, when there are no landmarks; -1 if all
+  // vertices are at distance 0
+  auto find_farthest = [&]() {
+    const SearchWorkspace* first_tree =
+        result.landmarks_.empty() ? &search(0) : nullptr;
+    int farthest = -1;
+    int64_t farthest_dist = 0;
+    for (int vertex = 0; vertex < n; ++vertex) {
+      int64_t distance = closest_dist[vertex];
+      if (first_tree) {
+        distance = first_tree->IsReached(vertex)
+            ? first_tree->GetDistance(vertex)
+            : 0;
+      }
+      if (distance > farthest_dist) {
+        farthest = vertex;
+        farthest_dist = distance;
+      }
+    }
+    return farthest;
+  };
+
+  std::mt19937 gen(n);
+  std::uniform_int_distribution<int> random_vertex(0, n - 1);
+  std::vector<int> weights(n);
+  std::vector<int64_t> sizes(n);
+  std::vector<int> best_children(n);
+  std::vector<int> order;
+  std::vector<int> children_begin(n + 1);
+  std::vector<int> children(n);
+  while (result.GetCount() < count) {
+    int landmark = -1;
+    if (selection == LandmarkSelection::kAvoid && !result.landmarks_.empty()) {
+      // weight of a vertex is how much the bound of its distance from the
+      // root is below the distance, size of a subtree is the sum of its
+      // weights, subtrees with landmarks are skipped; the landmark is found
+      // by going down from the largest subtree to its largest child
+      int root = random_vertex(gen);
+      const SearchWorkspace& root_tree = search(root);
+      executor::ParallelFor(
+          pool, 0, n, kChunkSize, [&](int, size_t begin, size_t end) {
+            for (size_t vertex = begin; vertex < end; ++vertex) {
+              int distance = root_tree.GetDistance(vertex);
+              int bound = 0;
+              for (const auto& column : columns) {
+                if (column[vertex] != kInf && column[root] != kInf) {
+                  bound = std::max(bound,
+                                   std::abs(column[vertex] - column[root]));
+                }
+              }
+              weights[vertex] = distance == kInf ? 0 : distance - bound;
+            }
+          });
+
+      // children lists, vertices are ordered from the root to leaves
+      std::fill(children_begin.begin(), children_begin.end(), 0);
+      for (int vertex = 0; vertex < n; ++vertex) {
+        if (root_tree.GetAncestor(vertex) != -1) {
+          ++children_begin[root_tree.GetAncestor(vertex) + 1];
+        }
+      }
+      std::partial_sum(children_begin.begin(), children_begin.end(),
+                       children_begin.begin());
+      std::vector<int> next_child(children_begin.begin(),
+                                  children_begin.end() - 1);
+      for (int vertex = 0; vertex < n; ++vertex) {
+        if (root_tree.GetAncestor(vertex) != -1) {
+          children[next_child[root_tree.GetAncestor(vertex)]++] = vertex;
+        }
+      }
+      order.assign(1, root);
+      for (int i = 0; i < order.size(); ++i) {
+        order.insert(order.end(),
+                     children.begin() + children_begin[order[i]],
+                     children.begin() + children_begin[order[i] + 1]);
+      }
+
+      for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int vertex = *it;
+        sizes[vertex] = weights[vertex];
+        best_children[vertex] = -1;
+        bool has_landmark = closest_dist[vertex] == 0;
+        for (int i = children_begin[vertex]; i < children_begin[vertex + 1];
+             ++i) {
+          int child = children[i];
+          // subtrees with landmarks have size -1
+          if (sizes[child] < 0) {
+            has_landmark = true;
+            continue;
+          }
+          sizes[vertex] += sizes[child];
+          if (best_children[vertex] == -1 ||
+              sizes[child] > sizes[best_children[vertex]]) {
+            best_children[vertex] = child;
+          }
+        }
+        if (has_landmark) {
+          sizes[vertex] = -1;
+        }
+      }
+      int largest = -1;
+      for (int vertex : order) {
+        if (sizes[vertex] > 0 &&
+            (largest == -1 || sizes[vertex] > sizes[largest])) {
+          largest = vertex;
+        }
+      }
+      if (largest != -1) {
+        landmark = largest;
+        while (best_children[landmark] != -1) {
+          landmark = best_children[landmark];
+        }
+      }
+    }
+    if (landmark == -1) {
+      landmark = find_farthest();
+    }
+    if (landmark == -1) {
+      if (!result.landmarks_.empty()) {
+        break;
+      }
+      landmark = 0;
+    }
+    add_landmark(landmark);
+  }
+
+  int landmarks_count = result.GetCount();
+  result.distances_.resize(static_cast<size_t>(n) * landmarks_count);
+  executor::ParallelFor(
+      pool, 0, n, kChunkSize, [&](int, size_t begin, size_t end) {
+        for (size_t vertex = begin; vertex < end; ++vertex) {
+          for (int i = 0; i < landmarks_count; ++i) {
+            result.distances_[vertex * landmarks_count + i] =
+                columns[i][vertex];
+          }
+        }
+      });
+  return result;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,427 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "algorithms.h"
+
+namespace algorithms {
+
+struct Shipment {
+  int from{0};
+  int to{0};
+  int amount{0};
+
+  bool operator==(const Shipment& other) const = default;
+};
+
+namespace min_cost_flow_details {
+
+constexpr int64_t kInfCost = std::numeric_limits<int64_t>::max();
+
+// Residual network of the graph, where every edge can carry any amount. Arcs
+// are edges of the graph in CSR layout, residual reverse arcs are found
+// through lists of incoming arcs.
+class ResidualNetwork {
+ public:
+  template<GraphStorage GraphType>
+  explicit ResidualNetwork(const GraphType& graph) {
+    int n = graph.GetSize();
+    first_arcs_.assign(n + 1, 0);
+    for (int from = 0; from < n; ++from) {
+      for (const auto& edge : graph.GetEdges(from)) {
+        heads_.push_back(edge.to);
+        tails_.push_back(from);
+        lengths_.push_back(edge.length);
+      }
+      first_arcs_[from + 1] = heads_.size();
+    }
+    flows_.assign(heads_.size(), 0);
+
+    first_incoming_.assign(n + 1, 0);
+    for (int head : heads_) {
+      ++first_incoming_[head + 1];
+    }
+    for (int vertex = 0; vertex < n; ++vertex) {
+      first_incoming_[vertex + 1] += first_incoming_[vertex];
+    }
+    incoming_.resize(heads_.size());
+    std::vector<int> positions(first_incoming_.begin(),
+                               first_incoming_.end() - 1);
+    for (int arc = 0; arc < heads_.size(); ++arc) {
+      incoming_[positions[heads_[arc]]++] = arc;
+    }
+  }
+
+  int GetSize() const {
+    return static_cast<int>(first_arcs_.size()) - 1;
+  }
+
+  // calls relax(to, cost, arc) for every residual arc from 'vertex', reverse
+  // arcs are passed as ~arc
+  template<typename Relax>
+  void ForEachResidualArc(int vertex, Relax relax) const {
+    for (int arc = first_arcs_[vertex]; arc < first_arcs_[vertex + 1];
+         ++arc) {
+      relax(heads_[arc], lengths_[arc], arc);
+    }
+    for (int i = first_incoming_[vertex]; i < first_incoming_[vertex + 1];
+         ++i) {
+      int arc = incoming_[i];
+      if (flows_[arc] > 0) {
+        relax(tails_[arc], -lengths_[arc], ~arc);
+      }
+    }
+  }
+
+  // residual arcs from 'vertex' are numbered from 0 to
+  // GetResidualDegree(vertex) - 1, reverse ones may have zero capacity
+  int GetResidualDegree(int vertex) const {
+    return first_arcs_[vertex + 1] - first_arcs_[vertex] +
+        first_incoming_[vertex + 1] - first_incoming_[vertex];
+  }
+  int GetResidualArc(int vertex, int index) const {
+    int out_degree = first_arcs_[vertex + 1] - first_arcs_[vertex];
+    return index < out_degree
+           ? first_arcs_[vertex] + index
+           : ~incoming_[first_incoming_[vertex] + index - out_degree];
+  }
+
+  int GetResidualHead(int residual_arc) const {
+    return residual_arc >= 0 ? heads_[residual_arc] : tails_[~residual_arc];
+  }
+  int64_t GetResidualCost(int residual_arc) const {
+    return residual_arc >= 0 ? lengths_[residual_arc]
+                             : -lengths_[~residual_arc];
+  }
+  // vertex, from which residual arc goes
+  int GetResidualTail(int residual_arc) const {
+    return residual_arc >= 0 ? tails_[residual_arc] : heads_[~residual_arc];
+  }
+  // how much can be sent along residual arc
+  int64_t GetResidualCapacity(int residual_arc) const {
+    return residual_arc >= 0 ? kInfCost : flows_[~residual_arc];
+  }
+  void Push(int residual_arc, int64_t amount) {
+    if (residual_arc >= 0) {
+      flows_[residual_arc] += amount;
+    } else {
+      flows_[~residual_arc] -= amount;
+    }
+  }
+
+  int GetFirstArc(int vertex) const {
+    return first_arcs_[vertex];
+  }
+  int GetArcsEnd(int vertex) const {
+    return first_arcs_[vertex + 1];
+  }
+  int GetHead(int arc) const {
+    return heads_[arc];
+  }
+  int64_t GetFlow(int arc) const {
+    return flows_[arc];
+  }
+  void SetFlow(int arc, int64_t flow) {
+    flows_[arc] = flow;
+  }
+
+ private:
+  std::vector<int> first_arcs_;
+  std::vector<int> heads_;
+  std::vector<int> tails_;
+  std::vector<int64_t> lengths_;
+  std::vector<int64_t> flows_;
+
+  std::vector<int> first_incoming_;
+  std::vector<int> incoming_;
+};
+
+// splits flow into paths from towns with supply to towns with demand,
+// flow cycles (possible only with zero length edges) are dropped
+inline std::vector<Shipment> DecomposeFlow(ResidualNetwork* network,
+                                           std::vector<int64_t> supplies) {
+  int n = network->GetSize();
+  std::vector<Shipment> shipments;
+  // first arc, which can still carry flow, for every vertex
+  std::vector<int> next_arcs(n);
+  for (int vertex = 0; vertex < n; ++vertex) {
+    next_arcs[vertex] = network->GetFirstArc(vertex);
+  }
+  std::vector<int> path_arcs;
+  std::vector<int> path_positions(n, -1);
+
+  for (int from = 0; from < n; ++from) {
+    while (supplies[from] > 0) {
+      path_arcs.clear();
+      path_positions[from] = 0;
+      int vertex = from;
+      while (supplies[vertex] >= 0) {
+        int& arc = next_arcs[vertex];
+        while (network->GetFlow(arc) == 0) {
+          ++arc;
+          assert(arc < network->GetArcsEnd(vertex));
+        }
+        path_arcs.push_back(arc);
+        vertex = network->GetHead(arc);
+        if (path_positions[vertex] != -1) {
+          // cycle, its flow doesn't move buns anywhere
+          int cycle_begin = path_positions[vertex];
+          int64_t cycle_flow = kInfCost;
+          for (int i = cycle_begin; i < path_arcs.size(); ++i) {
+            cycle_flow = std::min(cycle_flow, network->GetFlow(path_arcs[i]));
+          }
+          for (int i = cycle_begin; i < path_arcs.size(); ++i) {
+            network->SetFlow(path_arcs[i],
+                             network->GetFlow(path_arcs[i]) - cycle_flow);
+          }
+          for (int i = cycle_begin + 1; i < path_arcs.size(); ++i) {
+            path_positions[network->GetHead(path_arcs[i - 1])] = -1;
+          }
+          path_arcs.resize(cycle_begin);
+          continue;
+        }
+        path_positions[vertex] = path_arcs.size();
+      }
+
+      int64_t amount = std::min(supplies[from], -supplies[vertex]);
+      for (int arc : path_arcs) {
+        amount = std::min(amount, network->GetFlow(arc));
+      }
+      for (int arc : path_arcs) {
+        network->SetFlow(arc, network->GetFlow(arc) - amount);
+        path_positions[network->GetHead(arc)] = -1;
+      }
+      path_positions[from] = -1;
+      supplies[from] -= amount;
+      supplies[vertex] += amount;
+      shipments.push_back({from, vertex, static_cast<int>(amount)});
+    }
+  }
+  return shipments;
+}
+
+}  // namespace min_cost_flow_details
+
+// Minimum cost transportation over the graph: 'supplies[town]' is how much
+// the town has to send (negative if it has to receive), cost of moving a unit
+// is the length of its path. Supplies have to sum to zero. If the graph is
+// disconnected, supply, which can't reach any demand, stays in its town and
+// the demand stays unmet, the rest is shipped with minimal cost.
+// Primal-dual successive shortest paths: every phase is a Dijkstra search
+// over the residual network with non-negative reduced costs, which stops at
+// the closest demand, followed by pushing flow along all found shortest
+// paths, so the number of phases is usually much smaller than the number of
+// towns with non-zero supply.
+// Returns shipments between towns, merged by (from, to) pairs.
+template<GraphStorage GraphType>
+std::vector<Shipment> GetMinCostTransportation(
+    const GraphType& graph,
+    const std::vector<int>& supplies) {
+  using min_cost_flow_details::kInfCost;
+  int n = graph.GetSize();
+  assert(supplies.size() == n);
+  assert(std::accumulate(supplies.begin(), supplies.end(), int64_t{0}) == 0);
+
+  min_cost_flow_details::ResidualNetwork network(graph);
+  std::vector<int64_t> remaining(supplies.begin(), supplies.end());
+  // Virtual source is connected to every town with remaining supply and every
+  // town with remaining demand is connected to virtual sink by zero cost
+  // arcs. Potentials keep reduced costs of residual arcs non-negative, the
+  // potential of the source is always zero.
+  // Every phase finds distances from the source by Dijkstra search, which
+  // stops at the sink, updates potentials by them, so shortest paths consist
+  // of zero reduced cost arcs, and pushes flow along such paths found by
+  // depth-first searches, like Dinic's algorithm does in a level graph.
+  // Searches touch only a part of the graph, so potentials of the rest are
+  // shifted by a common offset and per-vertex state is reset by stamps.
+  std::vector<int64_t> potentials(n, 0);
+  int64_t potentials_offset = 0;
+  int64_t sink_potential = 0;
+  auto get_potential = [&](int vertex) {
+    return potentials[vertex] + potentials_offset;
+  };
+  auto get_reduced_cost = [&](int residual_arc) {
+    return network.GetResidualCost(residual_arc) +
+        get_potential(network.GetResidualTail(residual_arc)) -
+        get_potential(network.GetResidualHead(residual_arc));
+  };
+
+  std::vector<int64_t> distances(n);
+  // vertex is reached in the search of the current phase, if its stamp is
+  // equal to 'phase', and settled, if it's equal to 'phase' + 1
+  std::vector<uint64_t> stamps(n, 0);
+  uint64_t phase = 0;
+  std::vector<int> settled;
+  // the sink is stored as vertex n
+  std::vector<std::pair<int64_t, int>> heap;
+
+  // depth-first search state: index of the next residual arc to try, vertices
+  // without paths to the sink have it equal to their degree
+  std::vector<int> next_arc_indices(n);
+  std::vector<uint64_t> dfs_stamps(n, 0);
+  std::vector<bool> is_on_path(n, false);
+  std::vector<int> path;
+  std::vector<int> path_arcs;
+
+  std::vector<int> sources;
+  for (int town = 0; town < n; ++town) {
+    if (remaining[town] > 0) {
+      sources.push_back(town);
+    }
+  }
+
+  while (!sources.empty()) {
+    phase += 2;
+    settled.clear();
+    heap.clear();
+    for (int town : sources) {
+      stamps[town] = phase;
+      distances[town] = -get_potential(town);
+      heap.emplace_back(distances[town], town);
+    }
+    std::make_heap(heap.begin(), heap.end(), std::greater<>());
+
+    int64_t sink_distance = kInfCost;
+    while (!heap.empty()) {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+      auto [vertex_dist, vertex] = heap.back();
+      heap.pop_back();
+      if (vertex == n) {
+        break;
+      }
+      if (stamps[vertex] == phase + 1) {
+        continue;
+      }
+      stamps[vertex] = phase + 1;
+      settled.push_back(vertex);
+      int64_t vertex_potential = get_potential(vertex);
+      if (remaining[vertex] < 0 &&
+          vertex_dist + vertex_potential - sink_potential < sink_distance) {
+        sink_distance = vertex_dist + vertex_potential - sink_potential;
+        heap.emplace_back(sink_distance, n);
+        std::push_heap(heap.begin(), heap.end(), std::greater<>());
+      }
+      network.ForEachResidualArc(
+          vertex, [&](int to, int64_t cost, int) {
+            if (stamps[to] == phase + 1) {
+              return;
+            }
+            int64_t to_dist =
+                vertex_dist + cost + vertex_potential - get_potential(to);
+            if (stamps[to] != phase || to_dist < distances[to]) {
+              stamps[to] = phase;
+              distances[to] = to_dist;
+              heap.emplace_back(to_dist, to);
+              std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            }
+          });
+    }
+    if (sink_distance == kInfCost) {
+      // no remaining supply can reach remaining demand
+      break;
+    }
+
+    // settled vertices get their distances, the rest are at least as far as
+    // the sink
+    for (int vertex : settled) {
+      potentials[vertex] += distances[vertex] - sink_distance;
+    }
+    potentials_offset += sink_distance;
+    sink_potential += sink_distance;
+
+    for (int source : sources) {
+      // arc from the virtual source has to have zero reduced cost too
+      if (get_potential(source) != 0) {
+        continue;
+      }
+      while (remaining[source] > 0) {
+        path.assign(1, source);
+        path_arcs.clear();
+        is_on_path[source] = true;
+        while (!path.empty() && !(remaining[path.back()] < 0 &&
+            get_potential(path.back()) == sink_potential)) {
+          int vertex = path.back();
+          if (dfs_stamps[vertex] != phase) {
+            dfs_stamps[vertex] = phase;
+            next_arc_indices[vertex] = 0;
+          }
+          int& index = next_arc_indices[vertex];
+          for (; index < network.GetResidualDegree(vertex); ++index) {
+            int arc = network.GetResidualArc(vertex, index);
+            int to = network.GetResidualHead(arc);
+            bool is_dead = dfs_stamps[to] == phase &&
+                next_arc_indices[to] == network.GetResidualDegree(to);
+            if (network.GetResidualCapacity(arc) > 0 && !is_on_path[to] &&
+                !is_dead && get_reduced_cost(arc) == 0) {
+              break;
+            }
+          }
+          if (index < network.GetResidualDegree(vertex)) {
+            int arc = network.GetResidualArc(vertex, index);
+            path_arcs.push_back(arc);
+            path.push_back(network.GetResidualHead(arc));
+            is_on_path[path.back()] = true;
+          } else {
+            // no paths to the sink through the vertex
+            is_on_path[vertex] = false;
+            path.pop_back();
+            if (!path_arcs.empty()) {
+              path_arcs.pop_back();
+              ++next_arc_indices[path.back()];
+            }
+          }
+        }
+        if (path.empty()) {
+          break;
+        }
+
+        int sink = path.back();
+        int64_t amount = std::min(remaining[source], -remaining[sink]);
+        for (int arc : path_arcs) {
+          amount = std::min(amount, network.GetResidualCapacity(arc));
+        }
+        for (int arc : path_arcs) {
+          network.Push(arc, amount);
+        }
+        for (int vertex : path) {
+          is_on_path[vertex] = false;
+        }
+        remaining[source] -= amount;
+        remaining[sink] += amount;
+      }
+    }
+    std::erase_if(sources, [&remaining](int town) {
+      return remaining[town] == 0;
+    });
+  }
+
+  // only shipped amounts are decomposed
+  for (int town = 0; town < n; ++town) {
+    remaining[town] = supplies[town] - remaining[town];
+  }
+  std::vector<Shipment> shipments =
+      min_cost_flow_details::DecomposeFlow(&network, std::move(remaining));
+  std::sort(shipments.begin(), shipments.end(),
+            [](const Shipment& lhs, const Shipment& rhs) {
+              return std::pair(lhs.from, lhs.to) < std::pair(rhs.from, rhs.to);
+            });
+  std::vector<Shipment> merged;
+  for (const auto& shipment : shipments) {
+    if (!merged.empty() && merged.back().from == shipment.from &&
+        merged.back().to == shipment.to) {
+      merged.back().amount += shipment.amount;
+    } else {
+      merged.push_back(shipment);
+    }
+  }
+  return merged;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,44 @@
+#include "search_workspace.h"
+
+#include <algorithm>
+
+namespace algorithms {
+
+template<std::integral Distance>
+BasicSearchWorkspace<Distance>&
+BasicSearchWorkspace<Distance>::GetThreadLocal() {
+  thread_local BasicSearchWorkspace workspace;
+  return workspace;
+}
+
+template<std::integral Distance>
+BasicSearchWorkspace<Distance>&
+BasicSearchWorkspace<Distance>::GetGraphThreadLocal() {
+  thread_local BasicSearchWorkspace workspace;
+  return workspace;
+}
+
+template<std::integral Distance>
+void BasicSearchWorkspace<Distance>::Reset(int n) {
+  size_ = n;
+  heap_.clear();
+  queue_.clear();
+
+  if (reached_stamps_.size() < n) {
+    reached_stamps_.resize(n, generation_);
+    distances_.resize(n);
+    ancestors_.resize(n);
+  }
+
+  ++generation_;
+  // stamps of previous generations could be confused with the new one
+  if (generation_ == 0) {
+    std::fill(reached_stamps_.begin(), reached_stamps_.end(), 0);
+    generation_ = 1;
+  }
+}
+
+template class BasicSearchWorkspace<int>;
+template class BasicSearchWorkspace<int64_t>;
+
+}  // namespace algorithms
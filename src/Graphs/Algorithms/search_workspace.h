@@ -0,0 +1,92 @@
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "vertex_bitset.h"
+
+namespace algorithms {
+
+// distance of unreachable vertices, paths longer than it are unreachable too
+template<std::integral Distance>
+constexpr Distance kInfDistance = std::numeric_limits<Distance>::max();
+constexpr int kInf = kInfDistance<int>;
+
+// sum of non-negative distances, which is kInfDistance if it doesn't fit
+template<std::integral Distance>
+Distance SaturatingAdd(Distance lhs, Distance rhs) {
+  Distance sum;
+  if (__builtin_add_overflow(lhs, rhs, &sum)) {
+    return kInfDistance<Distance>;
+  }
+  return sum;
+}
+
+// Memory reused by consecutive searches. Every vertex is stamped with the
+// generation of the search, which wrote its values, so Reset() doesn't
+// touch per-vertex arrays unless the graph has grown.
+// Stores result of the last search: ancestor is previous vertex on the found
+// path (-1 for start and unreachable vertices), distance is length of it.
+// Instantiated in search_workspace.cpp for int and int64_t distances.
+template<std::integral Distance>
+class BasicSearchWorkspace {
+ public:
+  // workspace of the calling thread, used when none is passed to algorithm
+  static BasicSearchWorkspace& GetThreadLocal();
+  // another workspace of the calling thread for searches inside methods of
+  // graphs, e.g. Grid::GetDistance(), so they keep results of algorithms
+  // with the default workspace valid
+  static BasicSearchWorkspace& GetGraphThreadLocal();
+
+  void Reset(int n);
+
+  int GetSize() const {
+    return size_;
+  }
+
+  bool IsReached(int vertex) const {
+    return reached_stamps_[vertex] == generation_;
+  }
+  Distance GetDistance(int vertex) const {
+    return IsReached(vertex) ? distances_[vertex] : kInfDistance<Distance>;
+  }
+  int GetAncestor(int vertex) const {
+    return IsReached(vertex) ? ancestors_[vertex] : -1;
+  }
+  void Update(int vertex, Distance distance, int ancestor) {
+    reached_stamps_[vertex] = generation_;
+    distances_[vertex] = distance;
+    ancestors_[vertex] = ancestor;
+  }
+
+  // heap and queue are cleared by Reset(), but keep their capacity
+  std::vector<std::pair<Distance, int>>& GetHeap() {
+    return heap_;
+  }
+  std::vector<int>& GetQueue() {
+    return queue_;
+  }
+  // not cleared by Reset(), algorithms assign it themselves when they need it
+  VertexBitset& GetBitset() {
+    return bitset_;
+  }
+
+ private:
+  int size_{0};
+  uint32_t generation_{0};
+  std::vector<uint32_t> reached_stamps_;
+  std::vector<Distance> distances_;
+  std::vector<int> ancestors_;
+
+  std::vector<std::pair<Distance, int>> heap_;
+  std::vector<int> queue_;
+  VertexBitset bitset_;
+};
+
+using SearchWorkspace = BasicSearchWorkspace<int>;
+using WideSearchWorkspace = BasicSearchWorkspace<int64_t>;
+
+}  // namespace algorithms
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../../Executor/executor.h"
+#include "algorithms.h"
+
+namespace algorithms {
+
+// Shortest distances between given towns, found by one search from every
+// town, so planning doesn't touch the graph again. Searches run in parallel
+// on 'executor', nullptr means executor::GetDefaultExecutor(). Unreachable
+// towns are at distance kInf.
+class DistanceMatrix {
+ public:
+  template<GraphStorage GraphType>
+  DistanceMatrix(const GraphType& graph,
+                 std::vector<int> towns,
+                 executor::Executor* executor = nullptr)
+      : towns_(std::move(towns)) {
+    static_assert(std::is_same_v<DistanceType<GraphType>, int>,
+                  "tours are planned with int distances");
+    int size = GetSize();
+    distances_.resize(size * size);
+    executor::ParallelFor(
+        executor ? *executor : executor::GetDefaultExecutor(), 0, size, 1,
+        [&](int, size_t begin, size_t end) {
+          for (int from = begin; from < end; ++from) {
+            // every thread has its own workspace
+            const SearchWorkspace& tree = Dijkstra(graph, towns_[from]);
+            for (int to = 0; to < size; ++to) {
+              distances_[from * size + to] = tree.GetDistance(towns_[to]);
+            }
+          }
+        });
+  }
+  // distances are distance(from_town, to_town), e.g. of a distance oracle
+  template<typename DistanceFunction>
+    requires std::is_invocable_r_v<int, const DistanceFunction&, int, int>
+  DistanceMatrix(std::vector<int> towns, const DistanceFunction& distance)
+      : towns_(std::move(towns)) {
+    int size = GetSize();
+    distances_.resize(size * size);
+    for (int from = 0; from < size; ++from) {
+      for (int to = 0; to < size; ++to) {
+        distances_[from * size + to] = distance(towns_[from], towns_[to]);
+      }
+    }
+  }
+
+  int GetSize() const {
+    return towns_.size();
+  }
+  int GetTown(int index) const {
+    return towns_[index];
+  }
+  // between towns with indices 'from' and 'to' in the matrix
+  int GetDistance(int from, int to) const {
+    assert(0 <= from && from < GetSize());
+    assert(0 <= to && to < GetSize());
+    return distances_[from * GetSize() + to];
+  }
+
+ private:
+  std::vector<int> towns_;
+  std::vector<int> distances_;
+};
+
+// tour is a list of indices in the matrix, it starts at index 0 and ends at
+// its last stop
+inline int64_t GetTourLength(const DistanceMatrix& distances,
+                             const std::vector<int>& tour) {
+  int64_t length = 0;
+  int previous = 0;
+  for (int stop : tour) {
+    length += distances.GetDistance(previous, stop);
+    previous = stop;
+  }
+  return length;
+}
+
+// Plans tours from index 0 of the matrix, which deliver 'loads[index]' to
+// every other index with non-zero load. Loads of a tour sum to at most
+// 'capacity', vehicles don't return. Tours are built by savings heuristic
+// (Clarke-Wright for open tours): starting with a tour per stop, tours are
+// joined in order of decreasing saving d(0, j) - d(i, j) of going to the
+// first stop j of one tour from the last stop i of another instead of from
+// index 0. Then every tour is improved by 2-opt segment reversals.
+// Stops unreachable from index 0 get no tours, tours never use unreachable
+// pairs of stops, so their lengths are finite.
+inline std::vector<std::vector<int>> PlanTours(const DistanceMatrix& distances,
+                                               const std::vector<int>& loads,
+                                               int capacity) {
+  int size = distances.GetSize();
+  assert(loads.size() == size);
+
+  // tours are stored as lists of stops, 'tour_of' is the index of the tour,
+  // which contains the stop
+  std::vector<std::vector<int>> tours(size);
+  std::vector<int> tour_loads(size, 0);
+  std::vector<int> tour_of(size, -1);
+  for (int stop = 1; stop < size; ++stop) {
+    assert(0 <= loads[stop] && loads[stop] <= capacity);
+    if (loads[stop] > 0 && distances.GetDistance(0, stop) != kInf) {
+      tours[stop] = {stop};
+      tour_loads[stop] = loads[stop];
+      tour_of[stop] = stop;
+    }
+  }
+
+  // (saving, last stop, first stop)
+  std::vector<std::tuple<int, int, int>> savings;
+  for (int last = 1; last < size; ++last) {
+    for (int first = 1; first < size; ++first) {
+      if (last == first || tour_of[last] == -1 || tour_of[first] == -1) {
+        continue;
+      }
+      int saving = distances.GetDistance(0, first) -
+          distances.GetDistance(last, first);
+      if (saving > 0) {
+        savings.emplace_back(saving, last, first);
+      }
+    }
+  }
+  std::sort(savings.begin(), savings.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return std::get<0>(lhs) > std::get<0>(rhs) ||
+                  (std::get<0>(lhs) == std::get<0>(rhs) && lhs < rhs);
+            });
+
+  for (const auto& [saving, last, first] : savings) {
+    int last_tour = tour_of[last];
+    int first_tour = tour_of[first];
+    if (last_tour == first_tour || tours[last_tour].back() != last ||
+        tours[first_tour].front() != first ||
+        tour_loads[last_tour] + tour_loads[first_tour] > capacity) {
+      continue;
+    }
+    for (int stop : tours[first_tour]) {
+      tour_of[stop] = last_tour;
+    }
+    tours[last_tour].insert(tours[last_tour].end(),
+                            tours[first_tour].begin(),
+                            tours[first_tour].end());
+    tour_loads[last_tour] += tour_loads[first_tour];
+    tours[first_tour].clear();
+  }
+
+  std::vector<std::vector<int>> result;
+  for (auto& tour : tours) {
+    if (tour.empty()) {
+      continue;
+    }
+    // distances may be asymmetric, so a reversal changes lengths of the
+    // edges inside the segment too, their sums in both directions are kept
+    // as prefix sums, which makes checking a reversal O(1)
+    int tour_size = tour.size();
+    // 'forward[i]' and 'backward[i]' are sums over the first i edges
+    // between stops of the tour going along and against it
+    std::vector<int64_t> forward(tour_size, 0);
+    std::vector<int64_t> backward(tour_size, 0);
+    auto init_sums = [&]() {
+      for (int i = 0; i + 1 < tour_size; ++i) {
+        forward[i + 1] =
+            forward[i] + distances.GetDistance(tour[i], tour[i + 1]);
+        backward[i + 1] =
+            backward[i] + distances.GetDistance(tour[i + 1], tour[i]);
+      }
+    };
+    init_sums();
+    bool improved = true;
+    while (improved) {
+      improved = false;
+      for (int begin = 0; begin + 1 < tour_size; ++begin) {
+        int previous = begin == 0 ? 0 : tour[begin - 1];
+        for (int end = begin + 2; end <= tour_size; ++end) {
+          // segment [begin, end) is reversed
+          int first = tour[begin];
+          int last = tour[end - 1];
+          int64_t delta =
+              int64_t{distances.GetDistance(previous, last)} -
+              distances.GetDistance(previous, first) +
+              (backward[end - 1] - backward[begin]) -
+              (forward[end - 1] - forward[begin]);
+          if (end < tour_size) {
+            delta += int64_t{distances.GetDistance(first, tour[end])} -
+                distances.GetDistance(last, tour[end]);
+          }
+          if (delta < 0) {
+            std::reverse(tour.begin() + begin, tour.begin() + end);
+            init_sums();
+            improved = true;
+          }
+        }
+      }
+    }
+    result.push_back(std::move(tour));
+  }
+  return result;
+}
+
+}  // namespace algorithms
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace algorithms {
+
+// Set of vertices packed into 64-bit words. Scans skip whole words without
+// set bits, so iterating over the remaining vertices gets cheaper as they
+// are removed.
+class VertexBitset {
+ public:
+  VertexBitset() = default;
+
+  // resizes to 'size' bits, each equal to 'value', keeps allocated memory
+  void Assign(int size, bool value) {
+    size_ = size;
+    words_.assign((size + kWordBits - 1) / kWordBits,
+                  value ? ~uint64_t{0} : uint64_t{0});
+    // bits after the last one must stay unset for scans
+    if (value && size % kWordBits != 0) {
+      words_.back() = (uint64_t{1} << (size % kWordBits)) - 1;
+    }
+  }
+
+  int GetSize() const {
+    return size_;
+  }
+
+  bool Test(int index) const {
+    assert(0 <= index && index < size_);
+    return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+  }
+  void Set(int index) {
+    assert(0 <= index && index < size_);
+    words_[index / kWordBits] |= uint64_t{1} << (index % kWordBits);
+  }
+  void Reset(int index) {
+    assert(0 <= index && index < size_);
+    words_[index / kWordBits] &= ~(uint64_t{1} << (index % kWordBits));
+  }
+
+  // returns index of the first set bit or -1 if there are none
+  int FindFirst() const {
+    for (int word = 0; word < words_.size(); ++word) {
+      if (words_[word] != 0) {
+        return word * kWordBits + std::countr_zero(words_[word]);
+      }
+    }
+    return -1;
+  }
+
+  // calls function(index) for every set bit in increasing order
+  template<typename Function>
+  void ForEachSetBit(Function function) const {
+    for (int word = 0; word < words_.size(); ++word) {
+      for (uint64_t bits = words_[word]; bits != 0; bits &= bits - 1) {
+        function(word * kWordBits + std::countr_zero(bits));
+      }
+    }
+  }
+
+ private:
+  static constexpr int kWordBits = 64;
+
+  int size_{0};
+  std::vector<uint64_t> words_;
+};
+
+}  // namespace algorithms
@@ -1,6 +1,10 @@
 #include "chain.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
+
+#include "../Algorithms/search_workspace.h"
 
 Chain::Chain(int n) : AbstractGraph(n) {
   ResizeInternalVectors(n_);
@@ -13,6 +17,7 @@ Chain::Chain(int n) : AbstractGraph(n) {
     }
     AddMappingPair(i, i);
   }
+  InitPrefixLengths();
 }
 
 int GetBoundIndex(
@@ -42,6 +47,7 @@ Chain::Chain(const std::vector<std::vector<Edge>>& list) :
     int bound_index = GetBoundIndex(list);
     FillInternalVectors(bound_index, list);
   }
+  InitPrefixLengths();
 }
 
 void Chain::ResizeInternalVectors(int size) {
@@ -94,6 +100,15 @@ Chain::Chain(const std::vector<int>& edges_len_list) :
       nodes_list_[i].right_len = edges_len_list[i];
     }
   }
+  InitPrefixLengths();
+}
+
+void Chain::InitPrefixLengths() {
+  prefix_lengths_.assign(n_, 0);
+  for (int i = 1; i < n_; ++i) {
+    prefix_lengths_[i] =
+        prefix_lengths_[i - 1] + nodes_list_[i].left_len.value();
+  }
 }
 
 std::vector<Chain::Edge> Chain::GetEdges(int from) const {
@@ -148,3 +163,12 @@ std::vector<Chain::Edge> Chain::GetAnyPath(int from, int to) const {
   }
   return res;
 }
+
+int Chain::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  return std::min<int64_t>(
+      std::abs(prefix_lengths_[from_input_to_internal_[from]] -
+               prefix_lengths_[from_input_to_internal_[to]]),
+      algorithms::kInf);
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
+#include <vector>
 
 #include "../AbstractGraph/abstract_graph.h"
 
-class Chain : public AbstractGraph{
+class Chain final : public AbstractGraph {
  public:
   Chain() = default;
   // creates chain graph with n vertices and every edge's len = 1
@@ -21,8 +23,12 @@ class Chain : public AbstractGraph{
   std::vector<Edge> GetShortestPath(int from, int to) const override;
   std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
 
+  // O(1), by prefix sums of edge lengths
+  int GetDistance(int from, int to) const;
+
  private:
   void ResizeInternalVectors(int size);
+  void InitPrefixLengths();
   void FillInternalVectors(int cur_index,
                            const std::vector<std::vector<Edge>>& list);
   void AddMappingPair(int input_index, int internal_index);
@@ -35,4 +41,6 @@ class Chain : public AbstractGraph{
   std::vector<ChainNode> nodes_list_;
   std::vector<int> from_input_to_internal_;
   std::vector<int> from_internal_to_input_;
+  // prefix_lengths_[i] is the distance from internal 0 to internal i
+  std::vector<int64_t> prefix_lengths_;
 };
@@ -1,7 +1,8 @@
 #include "clique.h"
 
+#include <algorithm>
 #include <cassert>
-#include <limits>
+#include <cstdint>
 
 Clique::Clique(int n) : AbstractGraph(n) {
   adjacency_matrix_.resize(n);
@@ -24,6 +25,7 @@ Clique::Clique(const std::vector<std::vector<Edge>>& list) :
       adjacency_matrix_[i][edge.to] = edge.length;
     }
   }
+  InitMetricClosure();
 }
 
 Clique::Clique(const std::vector<std::vector<int>>& adjacency_matrix) :
@@ -32,6 +34,40 @@ Clique::Clique(const std::vector<std::vector<int>>& adjacency_matrix) :
     assert(adjacency_matrix[i].size() == adjacency_matrix.size());
   }
   adjacency_matrix_ = adjacency_matrix;
+  InitMetricClosure();
+}
+
+void Clique::InitMetricClosure() {
+  distances_.resize(n_ * n_);
+  next_vertices_.resize(n_ * n_);
+  for (int from = 0; from < n_; ++from) {
+    for (int to = 0; to < n_; ++to) {
+      distances_[from * n_ + to] =
+          from == to ? 0 : adjacency_matrix_[from][to];
+      next_vertices_[from * n_ + to] = to;
+    }
+  }
+  bool is_metric = true;
+  for (int middle = 0; middle < n_; ++middle) {
+    const int* middle_row = distances_.data() + middle * n_;
+    for (int from = 0; from < n_; ++from) {
+      int* row = distances_.data() + from * n_;
+      int64_t to_middle = row[middle];
+      for (int to = 0; to < n_; ++to) {
+        if (to_middle + middle_row[to] < row[to]) {
+          row[to] = to_middle + middle_row[to];
+          next_vertices_[from * n_ + to] = next_vertices_[from * n_ + middle];
+          is_metric = false;
+        }
+      }
+    }
+  }
+  if (is_metric) {
+    distances_.clear();
+    distances_.shrink_to_fit();
+    next_vertices_.clear();
+    next_vertices_.shrink_to_fit();
+  }
 }
 
 std::vector<Clique::Edge> Clique::GetEdges(int from) const {
@@ -46,6 +82,11 @@ std::vector<Clique::Edge> Clique::GetEdges(int from) const {
   return result;
 }
 
+const std::vector<int>& Clique::GetAdjacencyRow(int from) const {
+  assert(0 <= from && from < n_);
+  return adjacency_matrix_[from];
+}
+
 int Clique::GetEdgesCount() const {
   return n_ * (n_ - 1) / 2;
 }
@@ -57,60 +98,37 @@ std::vector<Clique::Edge> Clique::GetAnyPath(int from, int to) const {
   return {{to, adjacency_matrix_[from][to]}};
 }
 
-std::vector<int> Clique::GenerateShortestPathAncestors(int from) const {
-  const int kInf = std::numeric_limits<int>::max();
-  std::vector<int> distance(n_, kInf);
-  std::vector<int> ancestors(n_, -1);
-  std::vector<bool> is_used(n_, false);
-  distance[from] = 0;
-  for (int i = 0; i < n_; ++i) {
-    int cur_vertex = -1;
-    for (int new_best = 0; new_best < n_; ++new_best) {
-      if (!is_used[new_best] &&
-          (cur_vertex == -1 || distance[new_best] < distance[cur_vertex])) {
-        cur_vertex = new_best;
-      }
-    }
-    is_used[cur_vertex] = true;
-
-    for (int to = 0; to < n_; ++to) {
-      int len = adjacency_matrix_[cur_vertex][to];
-      if (distance[cur_vertex] + len < distance[to]) {
-        distance[to] = distance[cur_vertex] + len;
-        ancestors[to] = cur_vertex;
-      }
-    }
-  }
-  return ancestors;
-}
-
-std::vector<Clique::Edge> Clique::RestorePath(
-    const std::vector<int>& ancestors,
-    int to) const {
-  std::vector<Edge> path;
-  int cur = to;
-  while (ancestors[cur] != -1) {
-    path.emplace_back(cur, adjacency_matrix_[ancestors[cur]][cur]);
-    cur = ancestors[cur];
-  }
-  std::reverse(path.begin(), path.end());
-  return path;
-}
-
 std::vector<Clique::Edge> Clique::GetShortestPath(int from, int to) const {
   assert(0 <= from && from < n_);
   assert(0 <= to && to < n_);
-  return RestorePath(GenerateShortestPathAncestors(from), to);
+  if (next_vertices_.empty()) {
+    return GetAnyPath(from, to);
+  }
+  std::vector<Edge> result;
+  for (int vertex = from; vertex != to;) {
+    int next = next_vertices_[vertex * n_ + to];
+    result.emplace_back(next, adjacency_matrix_[vertex][next]);
+    vertex = next;
+  }
+  return result;
 }
 
 std::vector<std::vector<Clique::Edge>> Clique::GetShortestPaths(
     int from) const {
   assert(0 <= from && from < n_);
-  auto ancestors = GenerateShortestPathAncestors(from);
   std::vector<std::vector<Edge>> res;
   res.reserve(n_);
   for (int to = 0; to < n_; ++to) {
-    res.push_back(RestorePath(ancestors, to));
+    res.push_back(GetShortestPath(from, to));
   }
   return res;
 }
+
+int Clique::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  if (distances_.empty()) {
+    return from == to ? 0 : adjacency_matrix_[from][to];
+  }
+  return distances_[from * n_ + to];
+}
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <vector>
+
 #include "../AbstractGraph/abstract_graph.h"
 
-class Clique : public AbstractGraph {
+class Clique final : public AbstractGraph {
  public:
   Clique() = default;
   explicit Clique(int n);
@@ -10,18 +12,26 @@ class Clique : public AbstractGraph {
   explicit Clique(const std::vector<std::vector<int>>& adjacency_matrix);
 
   std::vector<Edge> GetEdges(int from) const override;
+  // lengths of edges from 'from' to every vertex, used by dense algorithms
+  const std::vector<int>& GetAdjacencyRow(int from) const;
 
   int GetEdgesCount() const override;
 
   std::vector<Edge> GetAnyPath(int from, int to) const override;
+  // O(path length) with the metric closure, which is found by construction
   std::vector<Edge> GetShortestPath(int from, int to) const override;
   std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
+  // O(1), length of the shortest path
+  int GetDistance(int from, int to) const;
 
  private:
-  std::vector<int> GenerateShortestPathAncestors(int from) const;
-  std::vector<Edge> RestorePath(
-      const std::vector<int>& ancestors,
-      int to) const;
+  // Floyd-Warshall in O(n^3), it's run once by constructors from lengths
+  void InitMetricClosure();
 
   std::vector<std::vector<int>> adjacency_matrix_;
+  // Shortest distances and next vertices of shortest paths, flattened as
+  // [from * n_ + to]. They are empty, when lengths satisfy the triangle
+  // inequality, then every edge is the shortest path.
+  std::vector<int> distances_;
+  std::vector<int> next_vertices_;
 };
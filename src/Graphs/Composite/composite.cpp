@@ -0,0 +1,347 @@
+#include "composite.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+const int kCitySize = 4;
+const int kCorridorSize = 2;
+
+// distances inside parts are int, Graph gives int64_t ones
+int ToPartDistance(int64_t distance) {
+  return distance >= algorithms::kInf ? algorithms::kInf
+                                      : static_cast<int>(distance);
+}
+
+std::vector<Composite::Part> GetCitiesAndCorridors(int n) {
+  std::vector<Composite::Part> parts;
+  for (int begin = 0; begin < n; begin += kCitySize + kCorridorSize) {
+    int city_end = std::min(begin + kCitySize, n);
+    Composite::Part city;
+    for (int vertex = begin; vertex < city_end; ++vertex) {
+      city.vertices.push_back(vertex);
+    }
+    city.graph = Clique(city_end - begin);
+    parts.push_back(std::move(city));
+
+    // from the last vertex of the city to the first one of the next city
+    int corridor_end = std::min(city_end + kCorridorSize + 1, n);
+    if (corridor_end - city_end > 0) {
+      Composite::Part corridor;
+      for (int vertex = city_end - 1; vertex < corridor_end; ++vertex) {
+        corridor.vertices.push_back(vertex);
+      }
+      corridor.graph = Chain(corridor_end - city_end + 1);
+      parts.push_back(std::move(corridor));
+    }
+  }
+  return parts;
+}
+
+}  // namespace
+
+Composite::Composite(int n) : Composite(n, GetCitiesAndCorridors(n)) {}
+
+Composite::Composite(int n, std::vector<Part> parts) :
+    AbstractGraph(n), parts_(std::move(parts)) {
+  membership_offsets_.assign(n_ + 1, 0);
+  for (const auto& part : parts_) {
+    assert(std::visit([](const auto& graph) { return graph.GetSize(); },
+                      part.graph) == part.vertices.size());
+    for (int vertex : part.vertices) {
+      assert(0 <= vertex && vertex < n_);
+      ++membership_offsets_[vertex + 1];
+    }
+  }
+  for (int vertex = 0; vertex < n_; ++vertex) {
+    membership_offsets_[vertex + 1] += membership_offsets_[vertex];
+  }
+  memberships_.resize(membership_offsets_[n_]);
+  std::vector<int> positions(membership_offsets_.begin(),
+                             membership_offsets_.end() - 1);
+  for (int part = 0; part < parts_.size(); ++part) {
+    for (int i = 0; i < parts_[part].vertices.size(); ++i) {
+      int vertex = parts_[part].vertices[i];
+      // a vertex is in a part once
+      assert(positions[vertex] == membership_offsets_[vertex] ||
+             memberships_[positions[vertex] - 1].part != part);
+      memberships_[positions[vertex]++] = {part, i};
+    }
+  }
+  InitOverlay();
+}
+
+void Composite::InitOverlay() {
+  boundary_indices_.assign(n_, -1);
+  for (int vertex = 0; vertex < n_; ++vertex) {
+    if (membership_offsets_[vertex + 1] - membership_offsets_[vertex] > 1) {
+      boundary_indices_[vertex] = boundary_vertices_.size();
+      boundary_vertices_.push_back(vertex);
+    }
+  }
+  int boundary_size = boundary_vertices_.size();
+
+  // one search in every part from each of its boundary vertices gives
+  // edges of the overlay and exits of the rest of the part
+  overlay_.assign(boundary_size, {});
+  std::vector<std::vector<std::pair<int, int>>> exits(n_);
+  for (int part = 0; part < parts_.size(); ++part) {
+    const auto& vertices = parts_[part].vertices;
+    for (int from = 0; from < vertices.size(); ++from) {
+      int from_boundary = boundary_indices_[vertices[from]];
+      if (from_boundary == -1) {
+        continue;
+      }
+      auto distances = GetPartDistances(part, from);
+      for (int to = 0; to < vertices.size(); ++to) {
+        if (to == from || distances[to] == algorithms::kInf) {
+          continue;
+        }
+        int to_boundary = boundary_indices_[vertices[to]];
+        if (to_boundary == -1) {
+          exits[vertices[to]].emplace_back(from_boundary, distances[to]);
+        } else {
+          overlay_[from_boundary].push_back(
+              {to_boundary, distances[to], part});
+        }
+      }
+    }
+  }
+
+  exit_offsets_.assign(n_ + 1, 0);
+  for (int vertex = 0; vertex < n_; ++vertex) {
+    if (boundary_indices_[vertex] != -1) {
+      exits[vertex] = {{boundary_indices_[vertex], 0}};
+    }
+    exit_offsets_[vertex + 1] = exit_offsets_[vertex] + exits[vertex].size();
+  }
+  exit_boundaries_.reserve(exit_offsets_[n_]);
+  exit_distances_.reserve(exit_offsets_[n_]);
+  for (const auto& vertex_exits : exits) {
+    for (const auto& [boundary, distance] : vertex_exits) {
+      exit_boundaries_.push_back(boundary);
+      exit_distances_.push_back(distance);
+    }
+  }
+
+}
+
+std::vector<int> Composite::GetPartDistances(int part, int from) const {
+  return std::visit([from](const auto& graph) {
+    std::vector<int> result(graph.GetSize());
+    // one search instead of a search for every vertex
+    if constexpr (std::is_same_v<std::decay_t<decltype(graph)>, Graph>) {
+      const auto& tree = algorithms::DijkstraForSparse(
+          graph, from, &algorithms::SearchWorkspace::GetGraphThreadLocal());
+      for (int to = 0; to < graph.GetSize(); ++to) {
+        result[to] = tree.GetDistance(to);
+      }
+    } else {
+      for (int to = 0; to < graph.GetSize(); ++to) {
+        result[to] = graph.GetDistance(from, to);
+      }
+    }
+    return result;
+  }, parts_[part].graph);
+}
+
+int Composite::GetPartDistance(int part, int from, int to) const {
+  return std::visit([from, to](const auto& graph) {
+    return ToPartDistance(graph.GetDistance(from, to));
+  }, parts_[part].graph);
+}
+
+int Composite::GetPartVertex(int vertex, int part) const {
+  for (int i = membership_offsets_[vertex];
+       i < membership_offsets_[vertex + 1]; ++i) {
+    if (memberships_[i].part == part) {
+      return memberships_[i].vertex;
+    }
+  }
+  return -1;
+}
+
+void Composite::AppendPartPath(int part, int from, int to,
+                               std::vector<Edge>* path) const {
+  const auto& vertices = parts_[part].vertices;
+  std::visit([&](const auto& graph) {
+    for (const auto& edge : graph.GetShortestPath(from, to)) {
+      path->emplace_back(vertices[edge.to], edge.length);
+    }
+  }, parts_[part].graph);
+}
+
+Composite::Route Composite::FindRoute(int from, int to) const {
+  Route result;
+  for (int i = membership_offsets_[from]; i < membership_offsets_[from + 1];
+       ++i) {
+    int part = memberships_[i].part;
+    int part_to = GetPartVertex(to, part);
+    if (part_to == -1) {
+      continue;
+    }
+    int distance = GetPartDistance(part, memberships_[i].vertex, part_to);
+    if (distance < result.distance) {
+      result = {distance, part, {}};
+    }
+  }
+
+  // the overlay is searched from an extra source vertex linked with exits
+  // of 'from', the search stops, when it can't improve the route
+  int boundary_size = boundary_vertices_.size();
+  std::vector<OverlayEdge> source_edges;
+  for (int i = exit_offsets_[from]; i < exit_offsets_[from + 1]; ++i) {
+    source_edges.push_back({exit_boundaries_[i], exit_distances_[i], -1});
+  }
+  if (source_edges.empty() || exit_offsets_[to] == exit_offsets_[to + 1]) {
+    return result;
+  }
+  int to_boundary = -1;
+  const auto& tree = algorithms::DijkstraForSparse(
+      OverlayStorage{overlay_, source_edges},
+      boundary_size,
+      [&](int vertex, int distance) {
+        if (distance >= result.distance) {
+          return false;
+        }
+        for (int i = exit_offsets_[to]; i < exit_offsets_[to + 1]; ++i) {
+          int64_t candidate = int64_t{distance} + exit_distances_[i];
+          if (exit_boundaries_[i] == vertex && candidate < result.distance) {
+            result.distance = static_cast<int>(candidate);
+            to_boundary = vertex;
+          }
+        }
+        return true;
+      },
+      &algorithms::SearchWorkspace::GetGraphThreadLocal());
+  if (to_boundary != -1) {
+    // the tree is restored now, as searches in parts reuse the workspace
+    result.part = -1;
+    for (int boundary = to_boundary; boundary != boundary_size;
+         boundary = tree.GetAncestor(boundary)) {
+      result.boundaries.push_back(boundary);
+    }
+    std::reverse(result.boundaries.begin(), result.boundaries.end());
+  }
+  return result;
+}
+
+std::vector<Composite::Edge> Composite::GetEdges(int from) const {
+  assert(0 <= from && from < n_);
+  std::vector<Edge> result;
+  for (int i = membership_offsets_[from]; i < membership_offsets_[from + 1];
+       ++i) {
+    const auto& part = parts_[memberships_[i].part];
+    std::visit([&](const auto& graph) {
+      for (const auto& edge : graph.GetEdges(memberships_[i].vertex)) {
+        result.emplace_back(part.vertices[edge.to], edge.length);
+      }
+    }, part.graph);
+  }
+  return result;
+}
+
+int Composite::GetEdgesCount() const {
+  int result = 0;
+  for (const auto& part : parts_) {
+    result += std::visit([](const auto& graph) {
+      return graph.GetEdgesCount();
+    }, part.graph);
+  }
+  return result;
+}
+
+int Composite::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  if (from == to) {
+    return 0;
+  }
+  return FindRoute(from, to).distance;
+}
+
+std::vector<Composite::Edge> Composite::GetAnyPath(int from, int to) const {
+  return GetShortestPath(from, to);
+}
+
+std::vector<Composite::Edge> Composite::GetShortestPath(int from,
+                                                        int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  if (from == to) {
+    return {};
+  }
+  Route route = FindRoute(from, to);
+  std::vector<Edge> result;
+  if (route.distance == algorithms::kInf) {
+    return result;
+  }
+  if (route.part != -1) {
+    AppendPartPath(route.part, GetPartVertex(from, route.part),
+                   GetPartVertex(to, route.part), &result);
+    return result;
+  }
+
+  // path inside the part of 'from' to its exit, if 'from' isn't boundary
+  auto append_inside_part = [&](int vertex, int boundary, bool to_boundary) {
+    int boundary_vertex = boundary_vertices_[boundary];
+    if (vertex == boundary_vertex) {
+      return;
+    }
+    int part = memberships_[membership_offsets_[vertex]].part;
+    int part_vertex = memberships_[membership_offsets_[vertex]].vertex;
+    int part_boundary = GetPartVertex(boundary_vertex, part);
+    if (to_boundary) {
+      AppendPartPath(part, part_vertex, part_boundary, &result);
+    } else {
+      AppendPartPath(part, part_boundary, part_vertex, &result);
+    }
+  };
+
+  append_inside_part(from, route.boundaries.front(), true);
+  for (int i = 0; i + 1 < route.boundaries.size(); ++i) {
+    int previous = route.boundaries[i];
+    int next = route.boundaries[i + 1];
+    // the edge, which the overlay search relaxed, is the shortest one
+    const OverlayEdge* best = nullptr;
+    for (const auto& edge : overlay_[previous]) {
+      if (edge.to == next && (!best || edge.length < best->length)) {
+        best = &edge;
+      }
+    }
+    assert(best);
+    AppendPartPath(best->part,
+                   GetPartVertex(boundary_vertices_[previous], best->part),
+                   GetPartVertex(boundary_vertices_[next], best->part),
+                   &result);
+  }
+  append_inside_part(to, route.boundaries.back(), false);
+  return result;
+}
+
+std::vector<std::vector<Composite::Edge>> Composite::GetShortestPaths(
+    int from) const {
+  std::vector<std::vector<Edge>> res;
+  res.reserve(n_);
+  for (int to = 0; to < n_; ++to) {
+    res.push_back(GetShortestPath(from, to));
+  }
+  return res;
+}
+
+int Composite::GetBoundarySize() const {
+  return boundary_vertices_.size();
+}
+
+int Composite::OverlayStorage::GetSize() const {
+  return overlay.size() + 1;
+}
+
+const std::vector<Composite::OverlayEdge>& Composite::OverlayStorage::GetEdges(
+    int from) const {
+  return from == overlay.size() ? source_edges : overlay[from];
+}
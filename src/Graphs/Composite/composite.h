@@ -0,0 +1,108 @@
+#pragma once
+
+#include <variant>
+#include <vector>
+
+#include "../AbstractGraph/abstract_graph.h"
+#include "../Chain/chain.h"
+#include "../Clique/clique.h"
+#include "../Graph/graph.h"
+
+// Network stitched of parts, e.g. dense city cores (Clique) connected by
+// highways (Chain), with Graph for the rest. Parts have their own vertices,
+// boundary vertices are the ones shared by several parts. The overlay of
+// boundary vertices is built once, every part links its boundary vertices
+// by distances inside it, so it takes O(sum of part boundaries^2) memory.
+// Distances from other vertices to boundary vertices of their parts are
+// stored too. A query searches the overlay from boundary vertices of the
+// part of 'from' and stops, when the route through boundary vertices of the
+// part of 'to' can't be improved.
+class Composite final : public AbstractGraph {
+ public:
+  struct Part {
+    // vertex i of the part is vertices[i] of the composite graph
+    std::vector<int> vertices;
+    std::variant<Graph, Clique, Chain> graph;
+  };
+
+  Composite() = default;
+  // creates cities of 4 vertices (Clique), every one linked with the next
+  // one by a corridor of 2 more vertices (Chain), every edge's len = 1
+  explicit Composite(int n);
+  // edges of a part must be symmetric, vertices not in parts are isolated
+  Composite(int n, std::vector<Part> parts);
+
+  std::vector<Edge> GetEdges(int from) const override;
+
+  int GetEdgesCount() const override;
+
+  std::vector<Edge> GetAnyPath(int from, int to) const override;
+  std::vector<Edge> GetShortestPath(int from, int to) const override;
+  std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
+
+  // algorithms::kInf if 'to' isn't reachable from 'from'
+  int GetDistance(int from, int to) const;
+
+  int GetBoundarySize() const;
+
+ private:
+  struct Membership {
+    int part;
+    int vertex;
+  };
+  // edge of the overlay between boundary indices, it's the shortest path
+  // inside 'part'
+  struct OverlayEdge {
+    int to;
+    int length;
+    int part;
+  };
+
+  // overlay with boundary indices for generic algorithms, the last vertex
+  // is the source of a query with 'source_edges'
+  struct OverlayStorage {
+    int GetSize() const;
+    const std::vector<OverlayEdge>& GetEdges(int from) const;
+
+    const std::vector<std::vector<OverlayEdge>>& overlay;
+    const std::vector<OverlayEdge>& source_edges;
+  };
+
+  // shortest path inside 'part', or through 'boundaries' (boundary indices
+  // on the overlay path), when 'part' is -1
+  struct Route {
+    int distance{algorithms::kInf};
+    int part{-1};
+    std::vector<int> boundaries;
+  };
+
+  // distances inside the part from its vertex 'from' to every its vertex
+  std::vector<int> GetPartDistances(int part, int from) const;
+  int GetPartDistance(int part, int from, int to) const;
+  // index of 'vertex' in the part, -1 if it isn't there
+  int GetPartVertex(int vertex, int part) const;
+  // appends path inside the part from its vertex 'from' to 'to' with
+  // indices of the composite graph
+  void AppendPartPath(int part, int from, int to,
+                      std::vector<Edge>* path) const;
+  void InitOverlay();
+  Route FindRoute(int from, int to) const;
+
+  std::vector<Part> parts_;
+  // parts of vertex i are [membership_offsets_[i], membership_offsets_[i + 1])
+  // of 'memberships_'
+  std::vector<int> membership_offsets_;
+  std::vector<Membership> memberships_;
+
+  // index among boundary vertices, -1 for other vertices
+  std::vector<int> boundary_indices_;
+  std::vector<int> boundary_vertices_;
+  std::vector<std::vector<OverlayEdge>> overlay_;
+
+  // exits of vertex i are boundary vertices of its part with distances to
+  // them, [exit_offsets_[i], exit_offsets_[i + 1]) of 'exit_boundaries_' and
+  // 'exit_distances_', a boundary vertex is the only exit of itself
+  std::vector<int> exit_offsets_;
+  std::vector<int> exit_boundaries_;
+  std::vector<int> exit_distances_;
+};
@@ -1,14 +1,69 @@
+#include <algorithm>
 #include <cassert>
 #include <cmath>
-#include <limits>
 #include <numeric>
-#include <queue>
 #include <utility>
 
 #include "graph.h"
 
-Graph::Graph(std::vector<std::vector<Edge>> list)
-    : AbstractGraph(list.size()), connections_(std::move(list)) {}
+#include "../Algorithms/delta_stepping.h"
+#include "../Algorithms/landmarks.h"
+
+namespace {
+
+// returns vertices in order of breadth-first traversal, every connected
+// component is traversed separately. If 'sort_by_degree' is set, traversal
+// starts from vertices with minimal degree and neighbours are visited in order
+// of increasing degree (Cuthill-McKee ordering)
+std::vector<int> GetBreadthFirstOrder(
+    const std::vector<std::vector<AbstractGraph::Edge>>& list,
+    bool sort_by_degree) {
+  int n = list.size();
+  auto degree_less = [&list](int lhs, int rhs) {
+    return list[lhs].size() < list[rhs].size();
+  };
+
+  std::vector<int> starts(n);
+  std::iota(starts.begin(), starts.end(), 0);
+  if (sort_by_degree) {
+    std::stable_sort(starts.begin(), starts.end(), degree_less);
+  }
+
+  std::vector<int> order;
+  order.reserve(n);
+  algorithms::VertexBitset is_used;
+  is_used.Assign(n, false);
+
+  for (int start : starts) {
+    if (is_used.Test(start)) {
+      continue;
+    }
+    is_used.Set(start);
+    order.push_back(start);
+
+    for (int head = order.size() - 1; head < order.size(); ++head) {
+      int first_new = order.size();
+      for (const auto& edge : list[order[head]]) {
+        if (!is_used.Test(edge.to)) {
+          is_used.Set(edge.to);
+          order.push_back(edge.to);
+        }
+      }
+      if (sort_by_degree) {
+        std::stable_sort(order.begin() + first_new, order.end(), degree_less);
+      }
+    }
+  }
+
+  return order;
+}
+
+}  // namespace
+
+Graph::Graph(std::vector<std::vector<Edge>> list, VertexOrder order)
+    : AbstractGraph(list.size()), connections_(std::move(list)) {
+  Relabel(order);
+}
 
 Graph::Graph(int n) : AbstractGraph(n) {
   connections_.resize(n);
@@ -20,180 +75,214 @@ Graph::Graph(int n) : AbstractGraph(n) {
       }
     }
   }
-}
-
 
-std::vector<Graph::Edge> Graph::GetEdges(int from) const {
-  assert(0 <= from && from < n_);
-
-  return connections_[from];
+  Relabel(VertexOrder::kInput);
 }
 
-std::vector<Graph::Edge> Graph::GetAnyPath(int from, int to) const {
-  assert(0 <= from && from < n_);
-  assert(0 <= to && to < n_);
+void Graph::Relabel(VertexOrder order) {
+  from_input_to_internal_.resize(n_);
+  from_internal_to_input_.resize(n_);
 
-  // stores edges to vertices, that will be explored later on
-  std::queue<Edge> edges_queue;
-  // stores vertices, that were explored
-  std::vector<bool> is_used(n_, false);
-  // used to restore path
-  std::vector<std::pair<Edge, int>>
-      ancestors(n_, std::make_pair(Edge(-1, -1), -1));
+  if (order == VertexOrder::kInput) {
+    for (int i = 0; i < n_; ++i) {
+      AddMappingPair(i, i);
+    }
+    return;
+  }
 
-  is_used[from] = true;
+  std::vector<int> vertices = GetBreadthFirstOrder(
+      connections_, order == VertexOrder::kReverseCuthillMcKee);
+  if (order == VertexOrder::kReverseCuthillMcKee) {
+    std::reverse(vertices.begin(), vertices.end());
+  }
+  for (int i = 0; i < n_; ++i) {
+    AddMappingPair(vertices[i], i);
+  }
 
-  edges_queue.push(Edge(from, -1));
+  std::vector<std::vector<Edge>> relabeled(n_);
+  for (int i = 0; i < n_; ++i) {
+    relabeled[i] = std::move(connections_[vertices[i]]);
+    for (auto& edge : relabeled[i]) {
+      edge.to = from_input_to_internal_[edge.to];
+    }
+  }
+  connections_ = std::move(relabeled);
+}
 
-  while (!edges_queue.empty()) {
-    Edge temp = edges_queue.front();
-    edges_queue.pop();
+void Graph::AddMappingPair(int input_index, int internal_index) {
+  from_input_to_internal_[input_index] = internal_index;
+  from_internal_to_input_[internal_index] = input_index;
+}
 
-    for (const auto& edge : GetEdges(temp.to)) {
-      if (!is_used[edge.to]) {
-        is_used[edge.to] = true;
-        edges_queue.push(edge);
-        ancestors[edge.to] = std::make_pair(edge, temp.to);
-      }
-    }
+std::vector<Graph::Edge> Graph::GetEdges(int from) const {
+  assert(0 <= from && from < n_);
+
+  std::vector<Edge> edges = connections_[from_input_to_internal_[from]];
+  for (auto& edge : edges) {
+    edge.to = from_internal_to_input_[edge.to];
   }
 
-  return RestorePath(ancestors, to);
+  return edges;
 }
 
-std::vector<Graph::Edge> Graph::RestorePath(
-    const std::vector<std::pair<Edge, int>>& ancestors,
-    int to) {
-  assert(0 <= to && to < ancestors.size());
+int Graph::InternalStorage::GetSize() const {
+  return connections.size();
+}
 
-  std::vector<Edge> path;
+const std::vector<Graph::Edge>& Graph::InternalStorage::GetEdges(
+    int from) const {
+  return connections[from];
+}
 
-  for (int i = to; ancestors[i].second != -1; i = ancestors[i].second) {
-    path.push_back(ancestors[i].first);
-  }
+template<typename Workspace>
+std::vector<Graph::Edge> Graph::RestorePath(const Workspace& tree,
+                                            int to) const {
+  return algorithms::RestorePath(tree, to, [this](int vertex) {
+    return from_internal_to_input_[vertex];
+  });
+}
+
+std::vector<Graph::Edge> Graph::GetAnyPath(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
 
-  std::reverse(path.begin(), path.end());
+  from = from_input_to_internal_[from];
+  to = from_input_to_internal_[to];
 
-  return path;
+  return RestorePath(
+      algorithms::BreadthFirstSearch(
+          InternalStorage{connections_}, from, to,
+          &algorithms::SearchWorkspace::GetGraphThreadLocal()),
+      to);
 }
 
-std::vector<std::pair<Graph::Edge, int>> Graph::GenerateShortestPathAncestors(
+const algorithms::SearchWorkspace& Graph::GenerateShortestPathTree(
     int from) const {
   int edges_count = GetEdgesCount();
+  InternalStorage storage{connections_};
+  auto* workspace = &algorithms::SearchWorkspace::GetGraphThreadLocal();
 
-  if (n_ * n_ + edges_count < edges_count * std::log(n_)) {
-    return DijkstraForDense(from);
+  if (shortest_path_algorithm_ == ShortestPathAlgorithm::kDeltaStepping) {
+    return algorithms::DeltaStepping(storage, from, {threads_count_},
+                                     workspace);
+  }
+  if (1LL * n_ * n_ + edges_count < edges_count * std::log(n_)) {
+    return algorithms::DijkstraForDense(storage, from, workspace);
   } else {
-    return DijkstraForSparse(from);
+    return algorithms::DijkstraForSparse(storage, from, workspace);
+  }
+}
+
+const algorithms::SearchWorkspace& Graph::GenerateShortestPathTree(
+    int from, int to) const {
+  if (landmarks_.GetCount() == 0) {
+    return GenerateShortestPathTree(from);
   }
+  return algorithms::GoalDirectedSearch(
+      InternalStorage{connections_},
+      from,
+      [this, to](int vertex) {
+        return landmarks_.GetLowerBound(vertex, to);
+      },
+      [to](int vertex, int) {
+        return vertex != to;
+      },
+      &algorithms::SearchWorkspace::GetGraphThreadLocal());
+}
+
+const algorithms::WideSearchWorkspace& Graph::GenerateWideShortestPathTree(
+    int from, int to) const {
+  return algorithms::DijkstraForSparse(
+      WideInternalStorage{{connections_}},
+      from,
+      [to](int vertex, int64_t) {
+        return vertex != to;
+      },
+      &algorithms::WideSearchWorkspace::GetGraphThreadLocal());
 }
 
 std::vector<Graph::Edge> Graph::GetShortestPath(int from, int to) const {
   assert(0 <= from && from < n_);
   assert(0 <= to && to < n_);
 
-  return RestorePath(GenerateShortestPathAncestors(from), to);
+  int internal_from = from_input_to_internal_[from];
+  int internal_to = from_input_to_internal_[to];
+  if (distance_width_ == DistanceWidth::k64Bit) {
+    return RestorePath(
+        GenerateWideShortestPathTree(internal_from, internal_to),
+        internal_to);
+  }
+  return RestorePath(GenerateShortestPathTree(internal_from, internal_to),
+                     internal_to);
 }
 
 std::vector<std::vector<Graph::Edge>> Graph::GetShortestPaths(
     int from)  const {
   assert(0 <= from && from < n_);
 
-  auto ancestors = GenerateShortestPathAncestors(from);
-
   std::vector<std::vector<Edge>> paths;
   paths.reserve(n_);
-
-  for (int i = 0; i < n_; ++i) {
-    paths.push_back(RestorePath(ancestors, i));
+  auto restore_paths = [this, &paths](const auto& tree) {
+    for (int i = 0; i < n_; ++i) {
+      paths.push_back(RestorePath(tree, from_input_to_internal_[i]));
+    }
+  };
+  if (distance_width_ == DistanceWidth::k64Bit) {
+    restore_paths(GenerateWideShortestPathTree(from_input_to_internal_[from]));
+  } else {
+    restore_paths(GenerateShortestPathTree(from_input_to_internal_[from]));
   }
 
   return paths;
 }
 
-int Graph::GetEdgesCount() const {
-  return std::accumulate(connections_.begin(),
-                         connections_.end(),
-                         0,
-                         [](int init, const auto& edges) {
-                           return init + edges.size();
-                         }) / 2;
-}
-
-std::vector<std::pair<Graph::Edge, int>> Graph::DijkstraForSparse(
-    int from) const {
+int64_t Graph::GetDistance(int from, int to) const {
   assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
 
-  const int kInf = std::numeric_limits<int>::max();
-
-  // stores vertices, that will be explored later on
-  std::priority_queue<std::pair<int, int>,
-                      std::vector<std::pair<int, int>>,
-                      std::greater<>> vertices_queue;
-  // used to restore path
-  std::vector<std::pair<Edge, int>>
-      ancestors(n_, std::make_pair(Edge(-1, -1), -1));
-  // dist[i] stores distance from 'from'-th vertex to i-th
-  std::vector<int> dist(n_, kInf);
-
-  dist[from] = 0;
-  vertices_queue.push(std::make_pair(0, from));
-
-  for (int i = 0; i < n_; ++i) {
-    int vertex = vertices_queue.top().second;
-
-    vertices_queue.pop();
-
-    for (const auto& edge : GetEdges(vertex)) {
-      if (dist[vertex] + edge.length < dist[edge.to]) {
-        dist[edge.to] = dist[vertex] + edge.length;
-        ancestors[edge.to] = std::make_pair(edge, vertex);
-        vertices_queue.push(std::make_pair(dist[edge.to], edge.to));
-      }
-    }
+  int internal_from = from_input_to_internal_[from];
+  int internal_to = from_input_to_internal_[to];
+  if (distance_width_ == DistanceWidth::k64Bit) {
+    return GenerateWideShortestPathTree(internal_from, internal_to)
+        .GetDistance(internal_to);
   }
-
-  return ancestors;
+  int distance = GenerateShortestPathTree(internal_from, internal_to)
+      .GetDistance(internal_to);
+  return distance == algorithms::kInf ? algorithms::kInfDistance<int64_t>
+                                      : distance;
 }
 
-std::vector<std::pair<Graph::Edge, int>> Graph::DijkstraForDense(
-    int from) const {
-  assert(0 <= from && from < n_);
-
-  const int kInf = std::numeric_limits<int>::max();
-
-  // stores vertices, that were explored
-  std::vector<bool> is_used(n_, false);
-  // used to restore path
-  std::vector<std::pair<Edge, int>>
-      ancestors(n_, std::make_pair(Edge(-1, -1), -1));
-  // dist[i] stores distance from 'from'-th vertex to i-th
-  std::vector<int> dist(n_, kInf);
-
-  dist[from] = 0;
-
-  for (int i = 0; i < n_; ++i) {
-    int vertex = -1;
+void Graph::SetDistanceWidth(DistanceWidth width) {
+  distance_width_ = width;
+}
 
-    for (int j = 0; j < n_; ++j) {
-      if ((!is_used[j]) && (vertex == -1 || dist[j] < dist[vertex])) {
-        vertex = j;
-      }
-    }
+void Graph::SetShortestPathAlgorithm(ShortestPathAlgorithm algorithm,
+                                     int threads_count) {
+  shortest_path_algorithm_ = algorithm;
+  threads_count_ = threads_count;
+}
 
-    if (dist[vertex] == kInf) {
-      break;
-    }
+void Graph::BuildLandmarks(int count,
+                           algorithms::LandmarkSelection selection,
+                           executor::Executor* executor) {
+  landmarks_ = algorithms::Landmarks::Build(InternalStorage{connections_},
+                                            count, selection, executor);
+}
 
-    is_used[vertex] = true;
+void Graph::SetLandmarks(algorithms::Landmarks landmarks) {
+  assert(landmarks.GetSize() == n_);
+  landmarks_ = std::move(landmarks);
+}
 
-    for (const auto& edge : GetEdges(vertex)) {
-      if (dist[vertex] + edge.length < dist[edge.to]) {
-        dist[edge.to] = dist[vertex] + edge.length;
-        ancestors[edge.to] = std::make_pair(edge, vertex);
-      }
-    }
-  }
+const algorithms::Landmarks& Graph::GetLandmarks() const {
+  return landmarks_;
+}
 
-  return ancestors;
+int Graph::GetEdgesCount() const {
+  return std::accumulate(connections_.begin(),
+                         connections_.end(),
+                         0,
+                         [](int init, const auto& edges) {
+                           return init + edges.size();
+                         }) / 2;
 }
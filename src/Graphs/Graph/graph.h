@@ -1,13 +1,39 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "../AbstractGraph/abstract_graph.h"
+#include "../../Executor/executor.h"
+#include "../Algorithms/algorithms.h"
+#include "../Algorithms/landmarks.h"
 
-class Graph : public AbstractGraph {
+class Graph final : public AbstractGraph {
  public:
+  // order in which vertices are stored internally, indices passed to and
+  // returned from public methods are always the input ones
+  enum class VertexOrder {
+    kInput,
+    kBreadthFirst,
+    kReverseCuthillMcKee,
+  };
+
+  enum class ShortestPathAlgorithm {
+    kDijkstra,
+    // parallel, for graphs with millions of vertices
+    kDeltaStepping,
+  };
+
+  // type of distances in searches, with k64Bit paths may be longer than
+  // int, searches are then Dijkstra, landmarks and delta stepping are unused
+  enum class DistanceWidth {
+    k32Bit,
+    k64Bit,
+  };
+
   Graph() = default;
-  explicit Graph(std::vector<std::vector<Edge>> list);
+  explicit Graph(std::vector<std::vector<Edge>> list,
+                 VertexOrder order = VertexOrder::kInput);
   // creates complete graph with n vertices
   explicit Graph(int n);
 
@@ -19,15 +45,65 @@ class Graph : public AbstractGraph {
   std::vector<Edge> GetShortestPath(int from, int to) const override;
   std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
 
+  // algorithms::kInfDistance<int64_t> if 'to' isn't reachable from 'from',
+  // with DistanceWidth::k32Bit also if the distance doesn't fit int
+  int64_t GetDistance(int from, int to) const;
+
+  void SetDistanceWidth(DistanceWidth width);
+
+  // algorithm used by GetShortestPath(s), 'threads_count' is passed to
+  // algorithms::DeltaStepping, 0 means all threads of the default executor
+  void SetShortestPathAlgorithm(ShortestPathAlgorithm algorithm,
+                                int threads_count = 0);
+
+  // With landmarks GetShortestPath is goal directed search (ALT), which
+  // stops at 'to'; they are valid only when every edge has the reverse one
+  // of the same length. Landmarks are stored with internal indices, so
+  // SetLandmarks() takes only GetLandmarks() of a graph with the same edges
+  // and vertex order.
+  void BuildLandmarks(
+      int count,
+      algorithms::LandmarkSelection selection =
+          algorithms::LandmarkSelection::kAvoid,
+      executor::Executor* executor = nullptr);
+  void SetLandmarks(algorithms::Landmarks landmarks);
+  const algorithms::Landmarks& GetLandmarks() const;
+
  private:
-  std::vector<std::pair<Edge, int>> GenerateShortestPathAncestors(
-      int from) const;
-  std::vector<std::pair<Edge, int>> DijkstraForDense(int from) const;
-  std::vector<std::pair<Edge, int>> DijkstraForSparse(int from) const;
-  static std::vector<Edge> RestorePath(
-      const std::vector<std::pair<Edge, int>>& ancestors,
-      int to);
+  void Relabel(VertexOrder order);
+  void AddMappingPair(int input_index, int internal_index);
+
+  // connections with internal indices for generic algorithms
+  struct InternalStorage {
+    int GetSize() const;
+    const std::vector<Edge>& GetEdges(int from) const;
+
+    const std::vector<std::vector<Edge>>& connections;
+  };
+  // the same with int64_t distances
+  struct WideInternalStorage : InternalStorage {
+    using Distance = int64_t;
+  };
+
+  // works with internal indices
+  const algorithms::SearchWorkspace& GenerateShortestPathTree(int from) const;
+  // stops at 'to', if search allows it
+  const algorithms::SearchWorkspace& GenerateShortestPathTree(int from,
+                                                              int to) const;
+  const algorithms::WideSearchWorkspace& GenerateWideShortestPathTree(
+      int from, int to = -1) const;
+  // 'to' is internal index, returns path with input indices
+  template<typename Workspace>
+  std::vector<Edge> RestorePath(const Workspace& tree, int to) const;
 
   std::vector<std::vector<Edge>> connections_;
-};
+  std::vector<int> from_input_to_internal_;
+  std::vector<int> from_internal_to_input_;
+
+  ShortestPathAlgorithm shortest_path_algorithm_{
+      ShortestPathAlgorithm::kDijkstra};
+  int threads_count_{0};
+  DistanceWidth distance_width_{DistanceWidth::k32Bit};
 
+  algorithms::Landmarks landmarks_;
+};
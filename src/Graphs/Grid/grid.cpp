@@ -0,0 +1,208 @@
+#include "grid.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#include "../Algorithms/algorithms.h"
+
+namespace {
+
+int GetSquarestColumns(int n) {
+  int columns = 1;
+  for (int i = 1; static_cast<int64_t>(i) * i <= n; ++i) {
+    if (n % i == 0) {
+      columns = i;
+    }
+  }
+  return n == 0 ? 0 : columns;
+}
+
+}  // namespace
+
+Grid::Grid(int n)
+    : Grid(n == 0 ? 0 : n / GetSquarestColumns(n), GetSquarestColumns(n)) {}
+
+Grid::Grid(int rows, int columns, int length)
+    : Grid(std::vector<int>(rows, length),
+           std::vector<int>(columns, length)) {}
+
+Grid::Grid(std::vector<int> row_lengths, std::vector<int> column_lengths) :
+    AbstractGraph(row_lengths.size() * column_lengths.size()),
+    row_lengths_(std::move(row_lengths)),
+    column_lengths_(std::move(column_lengths)) {
+  for (int length : row_lengths_) {
+    assert(length >= 0);
+    is_uniform_ = is_uniform_ && length == row_lengths_[0];
+  }
+  for (int length : column_lengths_) {
+    assert(length >= 0);
+    is_uniform_ = is_uniform_ &&
+        length == (row_lengths_.empty() ? column_lengths_[0]
+                                        : row_lengths_[0]);
+  }
+  tile_columns_ = (GetColumns() + kTileSide - 1) / kTileSide;
+}
+
+int Grid::GetRows() const {
+  return row_lengths_.size();
+}
+
+int Grid::GetColumns() const {
+  return column_lengths_.size();
+}
+
+std::vector<Grid::Edge> Grid::GetEdges(int from) const {
+  assert(0 <= from && from < n_);
+  std::vector<Edge> result;
+  for (const auto& edge : TiledStorage{*this}.GetEdges(ToTiled(from))) {
+    result.emplace_back(FromTiled(edge.to), edge.length);
+  }
+  return result;
+}
+
+int Grid::GetEdgesCount() const {
+  int rows = GetRows();
+  int columns = GetColumns();
+  if (rows == 0 || columns == 0) {
+    return 0;
+  }
+  return rows * (columns - 1) + columns * (rows - 1);
+}
+
+std::vector<Grid::Edge> Grid::GetAnyPath(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  int columns = GetColumns();
+  int row = from / columns;
+  int column = from % columns;
+  int to_row = to / columns;
+  int to_column = to % columns;
+
+  std::vector<Edge> result;
+  result.reserve(std::abs(row - to_row) + std::abs(column - to_column));
+  int column_step = column < to_column ? 1 : -1;
+  for (; column != to_column; column += column_step) {
+    result.emplace_back(row * columns + column + column_step,
+                        row_lengths_[row]);
+  }
+  int row_step = row < to_row ? 1 : -1;
+  for (; row != to_row; row += row_step) {
+    result.emplace_back((row + row_step) * columns + column,
+                        column_lengths_[column]);
+  }
+  return result;
+}
+
+std::vector<Grid::Edge> Grid::GetShortestPath(int from, int to) const {
+  if (is_uniform_) {
+    return GetAnyPath(from, to);
+  }
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  return RestorePath(Search(from, to), ToTiled(to));
+}
+
+std::vector<std::vector<Grid::Edge>> Grid::GetShortestPaths(int from) const {
+  assert(0 <= from && from < n_);
+  std::vector<std::vector<Edge>> res;
+  res.reserve(n_);
+  if (is_uniform_) {
+    for (int to = 0; to < n_; ++to) {
+      res.push_back(GetAnyPath(from, to));
+    }
+    return res;
+  }
+  const auto& tree = Search(from, -1);
+  for (int to = 0; to < n_; ++to) {
+    res.push_back(RestorePath(tree, ToTiled(to)));
+  }
+  return res;
+}
+
+int Grid::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  if (!is_uniform_) {
+    return Search(from, to).GetDistance(ToTiled(to));
+  }
+  int columns = GetColumns();
+  int64_t steps = std::abs(from / columns - to / columns) +
+      std::abs(from % columns - to % columns);
+  return std::min<int64_t>(steps * row_lengths_[0], algorithms::kInf);
+}
+
+int Grid::ToTiled(int vertex) const {
+  int row = vertex / GetColumns();
+  int column = vertex % GetColumns();
+  int tile = row / kTileSide * tile_columns_ + column / kTileSide;
+  return tile * kTileSize + row % kTileSide * kTileSide + column % kTileSide;
+}
+
+int Grid::FromTiled(int tiled_vertex) const {
+  int tile = tiled_vertex / kTileSize;
+  int inner = tiled_vertex % kTileSize;
+  int row = tile / tile_columns_ * kTileSide + inner / kTileSide;
+  int column = tile % tile_columns_ * kTileSide + inner % kTileSide;
+  return row * GetColumns() + column;
+}
+
+const algorithms::SearchWorkspace& Grid::Search(int from, int to) const {
+  int tiled_to = to == -1 ? -1 : ToTiled(to);
+  return algorithms::DijkstraForSparse(
+      TiledStorage{*this}, ToTiled(from), [tiled_to](int vertex, int) {
+        return vertex != tiled_to;
+      }, &algorithms::SearchWorkspace::GetGraphThreadLocal());
+}
+
+std::vector<Grid::Edge> Grid::RestorePath(
+    const algorithms::SearchWorkspace& tree,
+    int to) const {
+  return algorithms::RestorePath(tree, to, [this](int vertex) {
+    return FromTiled(vertex);
+  });
+}
+
+int Grid::TiledStorage::GetSize() const {
+  int tile_rows = (grid.GetRows() + kTileSide - 1) / kTileSide;
+  return tile_rows * grid.tile_columns_ * kTileSize;
+}
+
+Grid::TiledStorage::Neighbours Grid::TiledStorage::GetEdges(int from) const {
+  int tile = from / kTileSize;
+  int inner = from % kTileSize;
+  int row = tile / grid.tile_columns_ * kTileSide + inner / kTileSide;
+  int column = tile % grid.tile_columns_ * kTileSide + inner % kTileSide;
+  Neighbours result;
+  int rows = grid.GetRows();
+  int columns = grid.GetColumns();
+  // padding vertices
+  if (row >= rows || column >= columns) {
+    return result;
+  }
+  // neighbours inside the tile differ by a step within it, others are
+  // converted from grid coordinates
+  auto add = [&](int to_row, int to_column, int length) {
+    result.edges[result.size++] = Edge(
+        to_row / kTileSide == row / kTileSide &&
+            to_column / kTileSide == column / kTileSide
+            ? tile * kTileSize + to_row % kTileSide * kTileSide +
+                to_column % kTileSide
+            : grid.ToTiled(to_row * columns + to_column),
+        length);
+  };
+  if (row > 0) {
+    add(row - 1, column, grid.column_lengths_[column]);
+  }
+  if (column > 0) {
+    add(row, column - 1, grid.row_lengths_[row]);
+  }
+  if (column + 1 < columns) {
+    add(row, column + 1, grid.row_lengths_[row]);
+  }
+  if (row + 1 < rows) {
+    add(row + 1, column, grid.column_lengths_[column]);
+  }
+  return result;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "../AbstractGraph/abstract_graph.h"
+#include "../Algorithms/search_workspace.h"
+
+// Rectangular grid, where vertex of row r and column c is r * columns + c.
+// Edges aren't stored: edges along row r have length of the row, edges along
+// column c have length of the column. When all lengths are equal, distance
+// is Manhattan distance times the length and shortest paths go along the
+// row of 'from' and the column of 'to', otherwise searches run on vertices
+// numbered by square tiles, so neighbours of a vertex are mostly close to it
+// in memory.
+class Grid final : public AbstractGraph {
+ public:
+  Grid() = default;
+  // creates grid closest to square with n vertices (its number of columns
+  // divides n), every edge's len = 1
+  explicit Grid(int n);
+  Grid(int rows, int columns, int length = 1);
+  Grid(std::vector<int> row_lengths, std::vector<int> column_lengths);
+
+  int GetRows() const;
+  int GetColumns() const;
+
+  std::vector<Edge> GetEdges(int from) const override;
+
+  int GetEdgesCount() const override;
+
+  // along the row of 'from', then along the column of 'to'
+  std::vector<Edge> GetAnyPath(int from, int to) const override;
+  std::vector<Edge> GetShortestPath(int from, int to) const override;
+  std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
+
+  // O(1) when lengths are equal
+  int GetDistance(int from, int to) const;
+
+ private:
+  // side of square tiles, a power of two
+  static constexpr int kTileSide = 16;
+  static constexpr int kTileSize = kTileSide * kTileSide;
+
+  // grid with tiled indices for generic algorithms, it has padding vertices
+  // without edges, when sides aren't divisible by the tile side
+  struct TiledStorage {
+    // up to four edges, returned by value, so nothing is stored
+    struct Neighbours {
+      const Edge* begin() const {
+        return edges.data();
+      }
+      const Edge* end() const {
+        return edges.data() + size;
+      }
+
+      std::array<Edge, 4> edges{Edge(0, 0), Edge(0, 0), Edge(0, 0),
+                                Edge(0, 0)};
+      int size{0};
+    };
+
+    int GetSize() const;
+    Neighbours GetEdges(int from) const;
+
+    const Grid& grid;
+  };
+
+  int ToTiled(int vertex) const;
+  int FromTiled(int tiled_vertex) const;
+  // search from 'from', which stops at 'to', or explores the whole grid if
+  // 'to' is -1
+  const algorithms::SearchWorkspace& Search(int from, int to) const;
+  std::vector<Edge> RestorePath(const algorithms::SearchWorkspace& tree,
+                                int to) const;
+
+  std::vector<int> row_lengths_;
+  std::vector<int> column_lengths_;
+  bool is_uniform_{true};
+  int tile_columns_{0};
+};
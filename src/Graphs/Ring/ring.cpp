@@ -0,0 +1,138 @@
+#include "ring.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "../Algorithms/search_workspace.h"
+
+Ring::Ring(int n) : Ring(std::vector<int>(n, 1)) {}
+
+Ring::Ring(const std::vector<std::vector<Edge>>& list) :
+    AbstractGraph(list.size()) {
+  from_input_to_internal_.assign(n_, -1);
+  from_internal_to_input_.resize(n_);
+  prefix_lengths_.assign(n_ + 1, 0);
+  if (n_ == 0) {
+    return;
+  }
+  if (n_ == 1) {
+    assert(list[0].empty());
+    AddMappingPair(0, 0);
+    return;
+  }
+  for (int i = 0; i < n_; ++i) {
+    assert(list[i].size() == 2);
+  }
+
+  // goes along the ring from vertex 0 by its first edge, every next edge is
+  // the one, which doesn't lead back, the second edge of 0 closes the ring
+  AddMappingPair(0, 0);
+  int previous = 0;
+  Edge edge = list[0][0];
+  for (int internal_index = 1; internal_index < n_; ++internal_index) {
+    int vertex = edge.to;
+    assert(0 <= vertex && vertex < n_);
+    assert(from_input_to_internal_[vertex] == -1);
+    AddMappingPair(vertex, internal_index);
+    prefix_lengths_[internal_index] =
+        prefix_lengths_[internal_index - 1] + edge.length;
+    if (internal_index + 1 < n_) {
+      edge = list[vertex][0].to == previous ? list[vertex][1]
+                                            : list[vertex][0];
+      previous = vertex;
+    }
+  }
+  assert(list[0][1].to == from_internal_to_input_[n_ - 1]);
+  prefix_lengths_[n_] = prefix_lengths_[n_ - 1] + list[0][1].length;
+}
+
+Ring::Ring(const std::vector<int>& edges_len_list) :
+    AbstractGraph(edges_len_list.size()) {
+  from_input_to_internal_.resize(n_);
+  from_internal_to_input_.resize(n_);
+  prefix_lengths_.assign(n_ + 1, 0);
+  for (int i = 0; i < n_; ++i) {
+    AddMappingPair(i, i);
+    prefix_lengths_[i + 1] = prefix_lengths_[i] + edges_len_list[i];
+  }
+  if (n_ == 1) {
+    prefix_lengths_[1] = 0;
+  }
+}
+
+void Ring::AddMappingPair(int input_index, int internal_index) {
+  from_input_to_internal_[input_index] = internal_index;
+  from_internal_to_input_[internal_index] = input_index;
+}
+
+int64_t Ring::GetForwardLength(int from, int to) const {
+  if (from <= to) {
+    return prefix_lengths_[to] - prefix_lengths_[from];
+  }
+  return prefix_lengths_[n_] - (prefix_lengths_[from] - prefix_lengths_[to]);
+}
+
+int Ring::GetNextLength(int from) const {
+  return prefix_lengths_[from + 1] - prefix_lengths_[from];
+}
+
+std::vector<Ring::Edge> Ring::GetEdges(int from) const {
+  assert(0 <= from && from < n_);
+  if (n_ == 1) {
+    return {};
+  }
+  int internal_from = from_input_to_internal_[from];
+  int next = (internal_from + 1) % n_;
+  int previous = (internal_from + n_ - 1) % n_;
+  return {{from_internal_to_input_[previous], GetNextLength(previous)},
+          {from_internal_to_input_[next], GetNextLength(internal_from)}};
+}
+
+int Ring::GetEdgesCount() const {
+  return n_ >= 2 ? n_ : 0;
+}
+
+std::vector<Ring::Edge> Ring::GetAnyPath(int from, int to) const {
+  return GetShortestPath(from, to);
+}
+
+std::vector<Ring::Edge> Ring::GetShortestPath(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  int internal_from = from_input_to_internal_[from];
+  int internal_to = from_input_to_internal_[to];
+  std::vector<Edge> res;
+  int64_t forward_length = GetForwardLength(internal_from, internal_to);
+  if (forward_length <= prefix_lengths_[n_] - forward_length) {
+    for (int cur = internal_from; cur != internal_to; cur = (cur + 1) % n_) {
+      res.emplace_back(from_internal_to_input_[(cur + 1) % n_],
+                       GetNextLength(cur));
+    }
+  } else {
+    for (int cur = internal_from; cur != internal_to;
+         cur = (cur + n_ - 1) % n_) {
+      int previous = (cur + n_ - 1) % n_;
+      res.emplace_back(from_internal_to_input_[previous],
+                       GetNextLength(previous));
+    }
+  }
+  return res;
+}
+
+std::vector<std::vector<Ring::Edge>> Ring::GetShortestPaths(int from) const {
+  std::vector<std::vector<Edge>> res;
+  res.reserve(n_);
+  for (int to = 0; to < n_; ++to) {
+    res.push_back(GetShortestPath(from, to));
+  }
+  return res;
+}
+
+int Ring::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  int64_t forward_length = GetForwardLength(from_input_to_internal_[from],
+                                            from_input_to_internal_[to]);
+  return std::min({forward_length, prefix_lengths_[n_] - forward_length,
+                   int64_t{algorithms::kInf}});
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../AbstractGraph/abstract_graph.h"
+
+// Cycle, e.g. circular tram line or ring road. Vertices are stored in order
+// along the cycle with prefix sums of edge lengths, so the length of either
+// direction between two vertices, and the shortest path, are found in O(1).
+class Ring final : public AbstractGraph {
+ public:
+  Ring() = default;
+  // creates ring with n vertices, where i is connected to i + 1 and n - 1 to
+  // 0, and every edge's len = 1
+  explicit Ring(int n);
+  // every vertex has exactly two edges, one vertex has none
+  explicit Ring(const std::vector<std::vector<Edge>>& list);
+  // edge 'i' connects i with (i + 1) % n, where n = edges_len_list.size()
+  explicit Ring(const std::vector<int>& edges_len_list);
+
+  std::vector<Edge> GetEdges(int from) const override;
+
+  int GetEdgesCount() const override;
+
+  // O(path length), the shorter of two directions
+  std::vector<Edge> GetAnyPath(int from, int to) const override;
+  std::vector<Edge> GetShortestPath(int from, int to) const override;
+  std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
+
+  // O(1), length of the shortest path
+  int GetDistance(int from, int to) const;
+
+ private:
+  void AddMappingPair(int input_index, int internal_index);
+  // length of the way from internal 'from' to internal 'to' in order of
+  // internal indices
+  int64_t GetForwardLength(int from, int to) const;
+  // of the edge from internal 'from' to the next vertex
+  int GetNextLength(int from) const;
+
+  std::vector<int> from_input_to_internal_;
+  std::vector<int> from_internal_to_input_;
+  // prefix_lengths_[i] is the length of the way from internal 0 to internal
+  // i, the last one is the length of the whole ring
+  std::vector<int64_t> prefix_lengths_;
+};
@@ -0,0 +1,212 @@
+#include "tree.h"
+
+#include <bit>
+#include <numeric>
+
+Tree::Tree(int n) : Tree([n] {
+  std::vector<std::vector<Edge>> list(n);
+  for (int i = 1; i < n; ++i) {
+    list[i].emplace_back((i - 1) / 2, 1);
+    list[(i - 1) / 2].emplace_back(i, 1);
+  }
+  return list;
+}()) {}
+
+Tree::Tree(const std::vector<std::vector<Edge>>& list) :
+    AbstractGraph(list.size()) {
+  from_input_to_internal_.assign(n_, -1);
+  from_internal_to_input_.resize(n_);
+  parents_.resize(n_);
+  parent_lengths_.resize(n_);
+  depths_.resize(n_);
+  root_distances_.resize(n_);
+  subtree_ends_.resize(n_);
+  roots_.resize(n_);
+
+  // depth first search by stack of (vertex, parent, length of edge to it)
+  // with input indices, every vertex is pushed once, as there are no cycles
+  int internal_index = 0;
+  int64_t list_edges_count = 0;
+  std::vector<std::tuple<int, int, int>> stack;
+  for (int root = 0; root < n_; ++root) {
+    if (from_input_to_internal_[root] != -1) {
+      continue;
+    }
+    stack.emplace_back(root, -1, 0);
+    while (!stack.empty()) {
+      auto [vertex, parent, length] = stack.back();
+      stack.pop_back();
+      assert(from_input_to_internal_[vertex] == -1);
+      AddMappingPair(vertex, internal_index);
+      if (parent == -1) {
+        parents_[internal_index] = -1;
+        depths_[internal_index] = 0;
+        root_distances_[internal_index] = 0;
+        roots_[internal_index] = internal_index;
+      } else {
+        int internal_parent = from_input_to_internal_[parent];
+        parents_[internal_index] = internal_parent;
+        depths_[internal_index] = depths_[internal_parent] + 1;
+        root_distances_[internal_index] =
+            root_distances_[internal_parent] + length;
+        roots_[internal_index] = roots_[internal_parent];
+      }
+      parent_lengths_[internal_index] = length;
+      ++internal_index;
+
+      list_edges_count += list[vertex].size();
+      for (const auto& edge : list[vertex]) {
+        assert(0 <= edge.to && edge.to < n_);
+        if (edge.to != parent) {
+          stack.emplace_back(edge.to, vertex, edge.length);
+        }
+      }
+    }
+  }
+  // every edge is given twice, and a repeated edge to the parent is a cycle
+  assert(list_edges_count == 2 * static_cast<int64_t>(GetEdgesCount()));
+
+  std::iota(subtree_ends_.begin(), subtree_ends_.end(), 1);
+  for (int vertex = n_ - 1; vertex >= 0; --vertex) {
+    if (parents_[vertex] != -1) {
+      subtree_ends_[parents_[vertex]] =
+          std::max(subtree_ends_[parents_[vertex]], subtree_ends_[vertex]);
+    }
+  }
+
+  auto shallowest = [this](int lhs, int rhs) {
+    return depths_[lhs] <= depths_[rhs] ? lhs : rhs;
+  };
+  for (int half = 1; 2 * half <= n_; half *= 2) {
+    std::vector<int> level(n_ - 2 * half + 1);
+    for (int i = 0; i < level.size(); ++i) {
+      level[i] = half == 1
+          ? shallowest(i, i + 1)
+          : shallowest(sparse_table_.back()[i],
+                       sparse_table_.back()[i + half]);
+    }
+    sparse_table_.push_back(std::move(level));
+  }
+}
+
+void Tree::AddMappingPair(int input_index, int internal_index) {
+  from_input_to_internal_[input_index] = internal_index;
+  from_internal_to_input_[internal_index] = input_index;
+}
+
+std::vector<Tree::Edge> Tree::GetEdges(int from) const {
+  assert(0 <= from && from < n_);
+  int vertex = from_input_to_internal_[from];
+  std::vector<Edge> result;
+  if (parents_[vertex] != -1) {
+    result.emplace_back(from_internal_to_input_[parents_[vertex]],
+                        parent_lengths_[vertex]);
+  }
+  for (int child = vertex + 1; child < subtree_ends_[vertex];
+       child = subtree_ends_[child]) {
+    result.emplace_back(from_internal_to_input_[child],
+                        parent_lengths_[child]);
+  }
+  return result;
+}
+
+int Tree::GetEdgesCount() const {
+  int roots_count = 0;
+  for (int vertex = 0; vertex < n_; ++vertex) {
+    roots_count += parents_[vertex] == -1 ? 1 : 0;
+  }
+  return n_ - roots_count;
+}
+
+int Tree::GetLowestCommonAncestor(int lhs, int rhs) const {
+  if (lhs == rhs) {
+    return lhs;
+  }
+  if (lhs > rhs) {
+    std::swap(lhs, rhs);
+  }
+  // the shallowest of (lhs, rhs] is the child of the ancestor on the path
+  // to 'rhs'
+  int begin = lhs + 1;
+  int length = rhs - lhs;
+  if (length == 1) {
+    return parents_[rhs];
+  }
+  int level = std::bit_width(static_cast<unsigned>(length)) - 1;
+  int lhs_part = sparse_table_[level - 1][begin];
+  int rhs_part = sparse_table_[level - 1][rhs + 1 - (1 << level)];
+  return parents_[depths_[lhs_part] <= depths_[rhs_part] ? lhs_part
+                                                         : rhs_part];
+}
+
+int Tree::GetDistance(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  int internal_from = from_input_to_internal_[from];
+  int internal_to = from_input_to_internal_[to];
+  if (roots_[internal_from] != roots_[internal_to]) {
+    return algorithms::kInf;
+  }
+  int ancestor = GetLowestCommonAncestor(internal_from, internal_to);
+  return std::min<int64_t>(root_distances_[internal_from] +
+                               root_distances_[internal_to] -
+                               2 * root_distances_[ancestor],
+                           algorithms::kInf);
+}
+
+std::vector<Tree::Edge> Tree::GetAnyPath(int from, int to) const {
+  return GetShortestPath(from, to);
+}
+
+std::vector<Tree::Edge> Tree::GetShortestPath(int from, int to) const {
+  assert(0 <= from && from < n_);
+  assert(0 <= to && to < n_);
+  int internal_from = from_input_to_internal_[from];
+  int internal_to = from_input_to_internal_[to];
+  if (roots_[internal_from] != roots_[internal_to]) {
+    return {};
+  }
+  int ancestor = GetLowestCommonAncestor(internal_from, internal_to);
+
+  std::vector<Edge> result;
+  result.reserve(depths_[internal_from] + depths_[internal_to] -
+                 2 * depths_[ancestor]);
+  for (int vertex = internal_from; vertex != ancestor;
+       vertex = parents_[vertex]) {
+    result.emplace_back(from_internal_to_input_[parents_[vertex]],
+                        parent_lengths_[vertex]);
+  }
+  // edges down to 'to' are found from its end
+  size_t up_size = result.size();
+  for (int vertex = internal_to; vertex != ancestor;
+       vertex = parents_[vertex]) {
+    result.emplace_back(from_internal_to_input_[vertex],
+                        parent_lengths_[vertex]);
+  }
+  std::reverse(result.begin() + up_size, result.end());
+  return result;
+}
+
+std::vector<std::vector<Tree::Edge>> Tree::GetShortestPaths(int from) const {
+  std::vector<std::vector<Edge>> res;
+  res.reserve(n_);
+  for (int to = 0; to < n_; ++to) {
+    res.push_back(GetShortestPath(from, to));
+  }
+  return res;
+}
+
+int Tree::GetPreorderIndex(int vertex) const {
+  assert(0 <= vertex && vertex < n_);
+  return from_input_to_internal_[vertex];
+}
+
+int Tree::GetSubtreeEnd(int vertex) const {
+  assert(0 <= vertex && vertex < n_);
+  return subtree_ends_[from_input_to_internal_[vertex]];
+}
+
+int Tree::GetRoot(int vertex) const {
+  assert(0 <= vertex && vertex < n_);
+  return from_internal_to_input_[roots_[from_input_to_internal_[vertex]]];
+}
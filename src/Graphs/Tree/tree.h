@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include "../AbstractGraph/abstract_graph.h"
+#include "../Algorithms/search_workspace.h"
+
+// Forest, every path is the shortest one. Vertices are stored internally in
+// preorder of depth first search, so every subtree is a range of internal
+// indices. Distance of two vertices is found from distances to the root and
+// their lowest common ancestor, which is the parent of the shallowest vertex
+// between them in preorder, found by sparse table in O(1).
+class Tree final : public AbstractGraph {
+ public:
+  Tree() = default;
+  // creates complete binary tree with n vertices, where parent of i is
+  // (i - 1) / 2, and every edge's len = 1
+  explicit Tree(int n);
+  // every edge must be given in both directions, cycles are not allowed
+  explicit Tree(const std::vector<std::vector<Edge>>& list);
+
+  std::vector<Edge> GetEdges(int from) const override;
+
+  int GetEdgesCount() const override;
+
+  // O(path length), paths are empty, when vertices are in different trees
+  std::vector<Edge> GetAnyPath(int from, int to) const override;
+  std::vector<Edge> GetShortestPath(int from, int to) const override;
+  std::vector<std::vector<Edge>> GetShortestPaths(int from) const override;
+
+  // O(1), algorithms::kInf if vertices are in different trees
+  int GetDistance(int from, int to) const;
+
+  // subtree of 'vertex' is [GetPreorderIndex(vertex), GetSubtreeEnd(vertex))
+  // of preorder indices, the whole tree of 'vertex' is the subtree of its
+  // root, where preorder indices are from 0 to GetSize() - 1
+  int GetPreorderIndex(int vertex) const;
+  int GetSubtreeEnd(int vertex) const;
+  int GetRoot(int vertex) const;
+
+  // Visits vertices in order of increasing distance from 'from' (ties are
+  // broken by smaller index) while visitor(vertex, distance) returns true,
+  // as algorithms::VisitClosestVertices does. Every edge leads to a subtree
+  // or to the rest of the tree without one, and the search doesn't take it,
+  // when count_targets(begin, end) of preorder indices of that part is 0, so
+  // callers keeping aggregates by preorder index skip parts without targets.
+  template<typename Visitor, typename TargetsCounter>
+  void VisitClosestVertices(int from,
+                            Visitor visitor,
+                            TargetsCounter count_targets) const;
+
+ private:
+  void AddMappingPair(int input_index, int internal_index);
+  // internal indices
+  int GetLowestCommonAncestor(int lhs, int rhs) const;
+
+  std::vector<int> from_input_to_internal_;
+  std::vector<int> from_internal_to_input_;
+
+  // by internal index, parent is -1 for roots
+  std::vector<int> parents_;
+  std::vector<int> parent_lengths_;
+  std::vector<int> depths_;
+  std::vector<int64_t> root_distances_;
+  std::vector<int> subtree_ends_;
+  std::vector<int> roots_;
+  // sparse_table_[level][i] is the shallowest of internal indices
+  // [i, i + 2^(level + 1))
+  std::vector<std::vector<int>> sparse_table_;
+};
+
+template<typename Visitor, typename TargetsCounter>
+void Tree::VisitClosestVertices(int from,
+                                Visitor visitor,
+                                TargetsCounter count_targets) const {
+  assert(0 <= from && from < n_);
+  // (distance, input index, internal index, internal index of the vertex,
+  // from which it is reached)
+  using Entry = std::tuple<int, int, int, int>;
+  std::vector<Entry> heap = {{0, from, from_input_to_internal_[from], -1}};
+  auto push = [&](int distance, int vertex, int previous, int length) {
+    heap.emplace_back(algorithms::SaturatingAdd(distance, length),
+                      from_internal_to_input_[vertex], vertex, previous);
+    std::push_heap(heap.begin(), heap.end(), std::greater<>());
+  };
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+    auto [distance, input_vertex, vertex, previous] = heap.back();
+    heap.pop_back();
+    if (!visitor(input_vertex, distance)) {
+      return;
+    }
+    int parent = parents_[vertex];
+    if (parent != -1 && parent != previous) {
+      int root = roots_[vertex];
+      if (count_targets(root, vertex) +
+          count_targets(subtree_ends_[vertex], subtree_ends_[root]) > 0) {
+        push(distance, parent, vertex, parent_lengths_[vertex]);
+      }
+    }
+    for (int child = vertex + 1; child < subtree_ends_[vertex];
+         child = subtree_ends_[child]) {
+      if (child != previous &&
+          count_targets(child, subtree_ends_[child]) > 0) {
+        push(distance, child, vertex, parent_lengths_[child]);
+      }
+    }
+  }
+}
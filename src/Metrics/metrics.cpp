@@ -0,0 +1,176 @@
+#include "metrics.h"
+
+#include <algorithm>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace metrics {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadMetrics*> threads;
+  // metrics of finished threads
+  Snapshot finished;
+};
+
+Registry& GetRegistry() {
+  // never destroyed, so threads finishing after main() can still use it
+  static auto* registry = new Registry;
+  return *registry;
+}
+
+void AddTo(Snapshot* snapshot, const ThreadMetrics& thread_metrics) {
+  for (int i = 0; i < kCountersCount; ++i) {
+    snapshot->counters[i] +=
+        thread_metrics.counters[i].load(std::memory_order_relaxed);
+  }
+  for (int i = 0; i < kHistogramsCount; ++i) {
+    for (int bucket = 0; bucket < kHistogramBuckets; ++bucket) {
+      snapshot->histograms[i][bucket] +=
+          thread_metrics.histograms[i][bucket].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+}  // namespace
+
+const char* GetCounterName(Counter counter) {
+  switch (counter) {
+    case Counter::kBreadthFirstSearchRuns:
+      return "breadth_first_search_runs";
+    case Counter::kDijkstraRuns:
+      return "dijkstra_runs";
+    case Counter::kDeltaSteppingRuns:
+      return "delta_stepping_runs";
+    case Counter::kSettledVertices:
+      return "settled_vertices";
+    case Counter::kHeapPushes:
+      return "heap_pushes";
+    case Counter::kMoveClosestVehiclesCalls:
+      return "move_closest_vehicles_calls";
+    case Counter::kTransportFallbacks:
+      return "transport_fallbacks";
+    case Counter::kCount:
+      break;
+  }
+  return "";
+}
+
+const char* GetHistogramName(Histogram histogram) {
+  switch (histogram) {
+    case Histogram::kTransportNs:
+      return "transport_ns";
+    case Histogram::kTransportWithReturnsNs:
+      return "transport_with_returns_ns";
+    case Histogram::kMoveClosestVehiclesNs:
+      return "move_closest_vehicles_ns";
+    case Histogram::kPathEdges:
+      return "path_edges";
+    case Histogram::kCount:
+      break;
+  }
+  return "";
+}
+
+ThreadMetrics::ThreadMetrics() {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  registry.threads.push_back(this);
+}
+
+ThreadMetrics::~ThreadMetrics() {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  AddTo(&registry.finished, *this);
+  registry.threads.erase(
+      std::find(registry.threads.begin(), registry.threads.end(), this));
+}
+
+uint64_t Snapshot::GetCounter(Counter counter) const {
+  return counters[static_cast<int>(counter)];
+}
+
+uint64_t Snapshot::GetHistogramTotal(Histogram histogram) const {
+  const auto& buckets = histograms[static_cast<int>(histogram)];
+  uint64_t total = 0;
+  for (uint64_t count : buckets) {
+    total += count;
+  }
+  return total;
+}
+
+std::string Snapshot::ToText() const {
+  std::ostringstream output;
+  for (int i = 0; i < kCountersCount; ++i) {
+    output << GetCounterName(static_cast<Counter>(i)) << ": " << counters[i]
+           << '\n';
+  }
+  for (int i = 0; i < kHistogramsCount; ++i) {
+    output << GetHistogramName(static_cast<Histogram>(i)) << ":\n";
+    for (int bucket = 0; bucket < kHistogramBuckets; ++bucket) {
+      if (histograms[i][bucket] != 0) {
+        uint64_t lower = (bucket == 0) ? 0 : uint64_t{1} << (bucket - 1);
+        output << "  [" << lower << ", " << lower * 2 + (bucket == 0)
+               << "): " << histograms[i][bucket] << '\n';
+      }
+    }
+  }
+  return output.str();
+}
+
+std::string Snapshot::ToJson() const {
+  std::ostringstream output;
+  output << "{\"counters\": {";
+  for (int i = 0; i < kCountersCount; ++i) {
+    output << (i == 0 ? "" : ", ") << '"'
+           << GetCounterName(static_cast<Counter>(i)) << "\": " << counters[i];
+  }
+  // histograms are written as arrays of bucket counts up to the last
+  // non-empty one
+  output << "}, \"histograms\": {";
+  for (int i = 0; i < kHistogramsCount; ++i) {
+    int buckets_count = kHistogramBuckets;
+    while (buckets_count > 0 && histograms[i][buckets_count - 1] == 0) {
+      --buckets_count;
+    }
+    output << (i == 0 ? "" : ", ") << '"'
+           << GetHistogramName(static_cast<Histogram>(i)) << "\": [";
+    for (int bucket = 0; bucket < buckets_count; ++bucket) {
+      output << (bucket == 0 ? "" : ", ") << histograms[i][bucket];
+    }
+    output << ']';
+  }
+  output << "}}";
+  return output.str();
+}
+
+Snapshot Collect() {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  Snapshot snapshot = registry.finished;
+  for (const ThreadMetrics* thread_metrics : registry.threads) {
+    AddTo(&snapshot, *thread_metrics);
+  }
+  return snapshot;
+}
+
+void Reset() {
+  Registry& registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+  registry.finished = Snapshot();
+  for (ThreadMetrics* thread_metrics : registry.threads) {
+    for (auto& counter : thread_metrics->counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+    for (auto& histogram : thread_metrics->histograms) {
+      for (auto& bucket : histogram) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+}  // namespace metrics
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Hot path counters and histograms. They are collected only when the project
+// is configured with -DBUNS_ENABLE_METRICS=ON (which defines BUNS_METRICS),
+// otherwise METRICS_* macros expand to nothing.
+// Every thread writes to its own counters, Collect() sums them on demand.
+
+namespace metrics {
+
+enum class Counter {
+  kBreadthFirstSearchRuns,
+  kDijkstraRuns,
+  kDeltaSteppingRuns,
+  kSettledVertices,
+  kHeapPushes,
+  kMoveClosestVehiclesCalls,
+  // Transport calls, which didn't have enough vehicles in 'from' town
+  kTransportFallbacks,
+  kCount,
+};
+
+enum class Histogram {
+  kTransportNs,
+  kTransportWithReturnsNs,
+  kMoveClosestVehiclesNs,
+  // number of edges in paths, which vehicles are moved along
+  kPathEdges,
+  kCount,
+};
+
+const char* GetCounterName(Counter counter);
+const char* GetHistogramName(Histogram histogram);
+
+constexpr int kCountersCount = static_cast<int>(Counter::kCount);
+constexpr int kHistogramsCount = static_cast<int>(Histogram::kCount);
+// bucket i counts values with bit width i, i.e. in [2^(i - 1), 2^i)
+constexpr int kHistogramBuckets = 65;
+
+struct ThreadMetrics {
+  ThreadMetrics();
+  ~ThreadMetrics();
+
+  // written only by the owning thread, atomics make concurrent reads safe
+  std::array<std::atomic<uint64_t>, kCountersCount> counters{};
+  std::array<std::array<std::atomic<uint64_t>, kHistogramBuckets>,
+             kHistogramsCount> histograms{};
+};
+
+inline ThreadMetrics& GetThreadMetrics() {
+  thread_local ThreadMetrics thread_metrics;
+  return thread_metrics;
+}
+
+inline void Add(Counter counter, uint64_t value) {
+  auto& target = GetThreadMetrics().counters[static_cast<int>(counter)];
+  target.store(target.load(std::memory_order_relaxed) + value,
+               std::memory_order_relaxed);
+}
+
+inline void Record(Histogram histogram, uint64_t value) {
+  auto& target = GetThreadMetrics()
+      .histograms[static_cast<int>(histogram)][std::bit_width(value)];
+  target.store(target.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+}
+
+// records lifetime of the object in nanoseconds
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(Histogram histogram)
+      : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+  ~ScopedTimer() {
+    Record(histogram_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_).count());
+  }
+
+ private:
+  Histogram histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+struct Snapshot {
+  uint64_t GetCounter(Counter counter) const;
+  uint64_t GetHistogramTotal(Histogram histogram) const;
+
+  std::string ToText() const;
+  std::string ToJson() const;
+
+  std::array<uint64_t, kCountersCount> counters{};
+  std::array<std::array<uint64_t, kHistogramBuckets>, kHistogramsCount>
+      histograms{};
+};
+
+// sums metrics of all threads, including finished ones
+Snapshot Collect();
+// zeroes metrics of all threads
+void Reset();
+
+constexpr bool IsEnabled() {
+#ifdef BUNS_METRICS
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace metrics
+
+#ifdef BUNS_METRICS
+#define METRICS_ADD(counter, value) \
+  metrics::Add(metrics::Counter::counter, value)
+#define METRICS_RECORD(histogram, value) \
+  metrics::Record(metrics::Histogram::histogram, value)
+#define METRICS_SCOPED_TIMER(histogram) \
+  metrics::ScopedTimer metrics_scoped_timer(metrics::Histogram::histogram)
+#else
+// values are not evaluated
+#define METRICS_ADD(counter, value) static_cast<void>(sizeof(value))
+#define METRICS_RECORD(histogram, value) static_cast<void>(sizeof(value))
+#define METRICS_SCOPED_TIMER(histogram) static_cast<void>(0)
+#endif
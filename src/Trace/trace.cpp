@@ -0,0 +1,218 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <array>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+struct OperationFormat {
+  TraceOperation::Type type;
+  const char* name;
+  // -1 for a single vector argument
+  int arguments_count;
+};
+
+const std::array<OperationFormat, 8> kOperationFormats = {{
+    {TraceOperation::Type::kTransport, "Transport", 3},
+    {TraceOperation::Type::kTransportWithReturns, "TransportWithReturns", 3},
+    {TraceOperation::Type::kMoveVehicles, "MoveVehicles", 3},
+    {TraceOperation::Type::kSetBunsAmount, "SetBunsAmount", 2},
+    {TraceOperation::Type::kSetVehicle, "SetVehicle", 2},
+    {TraceOperation::Type::kSetBunsAmounts, "SetBunsAmounts", -1},
+    {TraceOperation::Type::kSetVehicles, "SetVehicles", -1},
+    {TraceOperation::Type::kSetFleet, "SetFleet", -1},
+}};
+
+const char* kVehicleCapacityHeader = "VehicleCapacity";
+const char* kVehicleTypesHeader = "VehicleTypes";
+
+}  // namespace
+
+const char* GetOperationName(TraceOperation::Type type) {
+  for (const auto& format : kOperationFormats) {
+    if (format.type == type) {
+      return format.name;
+    }
+  }
+  return "";
+}
+
+std::optional<Trace> ReadTrace(std::istream& input) {
+  Trace trace;
+  std::string word;
+  if (!(input >> word) || word != kVehicleCapacityHeader ||
+      !(input >> trace.vehicle_capacity) || trace.vehicle_capacity <= 0) {
+    return std::nullopt;
+  }
+
+  while (input >> word) {
+    if (word == kVehicleTypesHeader) {
+      int types_count = 0;
+      if (!trace.operations.empty() || !trace.vehicle_types.empty() ||
+          !(input >> types_count) || types_count <= 0) {
+        return std::nullopt;
+      }
+      trace.vehicle_types.resize(types_count);
+      for (auto& [capacity, time_multiplier] : trace.vehicle_types) {
+        if (!(input >> capacity >> time_multiplier) || capacity < 0 ||
+            time_multiplier <= 0) {
+          return std::nullopt;
+        }
+      }
+      continue;
+    }
+
+    auto format = std::find_if(kOperationFormats.begin(),
+                               kOperationFormats.end(),
+                               [&word](const OperationFormat& format) {
+                                 return word == format.name;
+                               });
+    if (format == kOperationFormats.end()) {
+      return std::nullopt;
+    }
+
+    TraceOperation operation{format->type, {}};
+    int arguments_count = format->arguments_count;
+    if (arguments_count == -1 &&
+        (!(input >> arguments_count) || arguments_count < 0)) {
+      return std::nullopt;
+    }
+    operation.arguments.resize(arguments_count);
+    for (auto& argument : operation.arguments) {
+      if (!(input >> argument)) {
+        return std::nullopt;
+      }
+    }
+    trace.operations.push_back(std::move(operation));
+  }
+
+  return trace;
+}
+
+void WriteTrace(std::ostream& output, const Trace& trace) {
+  output << kVehicleCapacityHeader << ' ' << trace.vehicle_capacity << '\n';
+  if (!trace.vehicle_types.empty()) {
+    output << kVehicleTypesHeader << ' ' << trace.vehicle_types.size();
+    for (const auto& [capacity, time_multiplier] : trace.vehicle_types) {
+      output << ' ' << capacity << ' ' << time_multiplier;
+    }
+    output << '\n';
+  }
+  for (const auto& operation : trace.operations) {
+    output << GetOperationName(operation.type);
+    if (operation.type == TraceOperation::Type::kSetBunsAmounts ||
+        operation.type == TraceOperation::Type::kSetVehicles ||
+        operation.type == TraceOperation::Type::kSetFleet) {
+      output << ' ' << operation.arguments.size();
+    }
+    for (int argument : operation.arguments) {
+      output << ' ' << argument;
+    }
+    output << '\n';
+  }
+}
+
+std::optional<std::vector<std::vector<AbstractGraph::Edge>>> ReadGraph(
+    std::istream& input) {
+  int vertices_count = 0;
+  int edges_count = 0;
+  if (!(input >> vertices_count >> edges_count) ||
+      vertices_count < 0 || edges_count < 0) {
+    return std::nullopt;
+  }
+
+  std::vector<std::vector<AbstractGraph::Edge>> list(vertices_count);
+  for (int i = 0; i < edges_count; ++i) {
+    int from = 0;
+    int to = 0;
+    int length = 0;
+    if (!(input >> from >> to >> length) ||
+        from < 0 || from >= vertices_count ||
+        to < 0 || to >= vertices_count || length < 0) {
+      return std::nullopt;
+    }
+    list[from].emplace_back(to, length);
+    list[to].emplace_back(from, length);
+  }
+
+  return list;
+}
+
+void WriteGraph(std::ostream& output, const AbstractGraph& graph) {
+  std::ostringstream edges;
+  int edges_count = 0;
+  for (int from = 0; from < graph.GetSize(); ++from) {
+    for (const auto& edge : graph.GetEdges(from)) {
+      if (from < edge.to) {
+        edges << from << ' ' << edge.to << ' ' << edge.length << '\n';
+        ++edges_count;
+      }
+    }
+  }
+  output << graph.GetSize() << ' ' << edges_count << '\n' << edges.str();
+}
+
+TraceRecorder::TraceRecorder(TrafficManager* traffic_manager,
+                             int vehicle_capacity) :
+    traffic_manager_(traffic_manager) {
+  trace_.vehicle_capacity = vehicle_capacity;
+  const auto& vehicle_types = traffic_manager_->GetVehicleTypes();
+  bool is_single_type = vehicle_types.size() == 1 &&
+      vehicle_types[0].capacity == vehicle_capacity &&
+      vehicle_types[0].time_multiplier == 1;
+  // makes trace independent of the state manager was created with
+  trace_.operations.push_back({TraceOperation::Type::kSetBunsAmounts,
+                               traffic_manager_->GetBunsAmounts()});
+  if (is_single_type) {
+    trace_.operations.push_back({TraceOperation::Type::kSetVehicles,
+                                 traffic_manager_->GetVehicles()});
+  } else {
+    trace_.vehicle_types = vehicle_types;
+    trace_.operations.push_back({TraceOperation::Type::kSetFleet,
+                                 traffic_manager_->GetFleet()});
+  }
+}
+
+int TraceRecorder::MoveVehicles(int from, int to, int count) {
+  return Record({TraceOperation::Type::kMoveVehicles, {from, to, count}});
+}
+
+int TraceRecorder::Transport(int from, int to, int buns_amount) {
+  return Record({TraceOperation::Type::kTransport, {from, to, buns_amount}});
+}
+
+int TraceRecorder::TransportWithReturns(int from, int to, int buns_amount) {
+  return Record({TraceOperation::Type::kTransportWithReturns,
+                 {from, to, buns_amount}});
+}
+
+void TraceRecorder::SetBunsAmounts(std::vector<int> buns_amounts) {
+  Record({TraceOperation::Type::kSetBunsAmounts, std::move(buns_amounts)});
+}
+
+void TraceRecorder::SetVehicles(std::vector<int> vehicles) {
+  Record({TraceOperation::Type::kSetVehicles, std::move(vehicles)});
+}
+
+void TraceRecorder::SetFleet(std::vector<int> fleet) {
+  Record({TraceOperation::Type::kSetFleet, std::move(fleet)});
+}
+
+void TraceRecorder::SetBunsAmount(int town, int buns_amount) {
+  Record({TraceOperation::Type::kSetBunsAmount, {town, buns_amount}});
+}
+
+void TraceRecorder::SetVehicle(int town, int vehicle) {
+  Record({TraceOperation::Type::kSetVehicle, {town, vehicle}});
+}
+
+const Trace& TraceRecorder::GetTrace() const {
+  return trace_;
+}
+
+int TraceRecorder::Record(TraceOperation operation) {
+  trace_.operations.push_back(std::move(operation));
+  return ApplyOperation(traffic_manager_, trace_.operations.back());
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../Graphs/AbstractGraph/abstract_graph.h"
+#include "../TrafficManager/traffic_manager.h"
+
+// Text format of traces: the first line is "VehicleCapacity <capacity>",
+// every next line is one TrafficManager call: its name followed by its
+// arguments, vectors are written as their size followed by elements, e.g.
+//   VehicleCapacity 10
+//   SetBunsAmounts 3 5 0 7
+//   Transport 0 2 4
+// Traces of fleets with several vehicle types have the second line
+// "VehicleTypes <count>" followed by capacity and time multiplier of every
+// type, the fleet is set by SetFleet then, e.g.
+//   VehicleCapacity 5
+//   VehicleTypes 2 5 1 20 3
+//   SetFleet 6 1 0 0 2 4 1
+
+struct TraceOperation {
+  enum class Type {
+    kTransport,
+    kTransportWithReturns,
+    kMoveVehicles,
+    kSetBunsAmount,
+    kSetVehicle,
+    kSetBunsAmounts,
+    kSetVehicles,
+    kSetFleet,
+  };
+
+  bool operator==(const TraceOperation& rhs) const = default;
+
+  Type type{Type::kTransport};
+  // scalar arguments in order of declaration, single vector argument for
+  // kSetBunsAmounts, kSetVehicles and kSetFleet
+  std::vector<int> arguments;
+};
+
+struct Trace {
+  bool operator==(const Trace& rhs) const = default;
+
+  int vehicle_capacity{1};
+  // empty if all vehicles are of one type with 'vehicle_capacity' and
+  // multiplier 1
+  std::vector<TrafficManager::VehicleType> vehicle_types;
+  std::vector<TraceOperation> operations;
+};
+
+const char* GetOperationName(TraceOperation::Type type);
+
+// returns std::nullopt if input is malformed
+std::optional<Trace> ReadTrace(std::istream& input);
+void WriteTrace(std::ostream& output, const Trace& trace);
+
+// Graph files start with "<vertices count> <edges count>" followed by
+// "<from> <to> <length>" lines, every edge is undirected, lengths aren't
+// negative.
+// returns std::nullopt if input is malformed
+std::optional<std::vector<std::vector<AbstractGraph::Edge>>> ReadGraph(
+    std::istream& input);
+void WriteGraph(std::ostream& output, const AbstractGraph& graph);
+
+// manager without buns and vehicles with the fleet of the trace, which its
+// operations are applied to
+template<typename GraphType>
+BasicTrafficManager<GraphType> CreateTraceManager(const GraphType* graph,
+                                                  const Trace& trace) {
+  int towns_count = graph->GetSize();
+  if (trace.vehicle_types.empty()) {
+    return BasicTrafficManager<GraphType>(
+        graph, std::vector<int>(towns_count, 0),
+        std::vector<int>(towns_count, 0), trace.vehicle_capacity);
+  }
+  std::vector<typename BasicTrafficManager<GraphType>::VehicleType>
+      vehicle_types;
+  for (const auto& [capacity, time_multiplier] : trace.vehicle_types) {
+    vehicle_types.push_back({capacity, time_multiplier});
+  }
+  int fleet_size = towns_count * vehicle_types.size();
+  return BasicTrafficManager<GraphType>(
+      graph, std::vector<int>(towns_count, 0), std::move(vehicle_types),
+      std::vector<int>(fleet_size, 0));
+}
+
+// Traces are read from files, so operations are checked against the manager
+// before they are applied: towns are in range, vectors have an amount for
+// every town, amounts aren't negative and 'from' has the buns to transport.
+template<typename GraphType>
+bool IsValidOperation(const BasicTrafficManager<GraphType>& traffic_manager,
+                      const TraceOperation& operation) {
+  const auto& arguments = operation.arguments;
+  int towns_count = traffic_manager.GetVehicles().size();
+  auto is_town = [towns_count](int town) {
+    return 0 <= town && town < towns_count;
+  };
+  switch (operation.type) {
+    case TraceOperation::Type::kTransport:
+    case TraceOperation::Type::kTransportWithReturns:
+      return arguments.size() == 3 && is_town(arguments[0]) &&
+          is_town(arguments[1]) && arguments[2] >= 0 &&
+          traffic_manager.GetBunsAmount(arguments[0]) >= arguments[2];
+    case TraceOperation::Type::kMoveVehicles:
+      return arguments.size() == 3 && is_town(arguments[0]) &&
+          is_town(arguments[1]) && arguments[2] >= 0;
+    case TraceOperation::Type::kSetBunsAmount:
+    case TraceOperation::Type::kSetVehicle:
+      return arguments.size() == 2 && is_town(arguments[0]) &&
+          arguments[1] >= 0;
+    case TraceOperation::Type::kSetBunsAmounts:
+    case TraceOperation::Type::kSetVehicles:
+      return arguments.size() == towns_count &&
+          std::all_of(arguments.begin(), arguments.end(),
+                      [](int amount) { return amount >= 0; });
+    case TraceOperation::Type::kSetFleet:
+      return arguments.size() ==
+          towns_count * traffic_manager.GetVehicleTypes().size() &&
+          std::all_of(arguments.begin(), arguments.end(),
+                      [](int amount) { return amount >= 0; });
+  }
+  return false;
+}
+
+// calls TrafficManager method described by the operation, returns its result
+// or 0 for methods without result; the operation must be valid
+template<typename GraphType>
+int ApplyOperation(BasicTrafficManager<GraphType>* traffic_manager,
+                   const TraceOperation& operation) {
+  const auto& arguments = operation.arguments;
+  switch (operation.type) {
+    case TraceOperation::Type::kTransport:
+      return traffic_manager->Transport(
+          arguments[0], arguments[1], arguments[2]);
+    case TraceOperation::Type::kTransportWithReturns:
+      return traffic_manager->TransportWithReturns(
+          arguments[0], arguments[1], arguments[2]);
+    case TraceOperation::Type::kMoveVehicles:
+      return traffic_manager->MoveVehicles(
+          arguments[0], arguments[1], arguments[2]);
+    case TraceOperation::Type::kSetBunsAmount:
+      traffic_manager->SetBunsAmount(arguments[0], arguments[1]);
+      return 0;
+    case TraceOperation::Type::kSetVehicle:
+      traffic_manager->SetVehicle(arguments[0], arguments[1]);
+      return 0;
+    case TraceOperation::Type::kSetBunsAmounts:
+      traffic_manager->SetBunsAmounts(arguments);
+      return 0;
+    case TraceOperation::Type::kSetVehicles:
+      traffic_manager->SetVehicles(arguments);
+      return 0;
+    case TraceOperation::Type::kSetFleet:
+      traffic_manager->SetFleet(arguments);
+      return 0;
+  }
+  return 0;
+}
+
+// FNV-1a hash of buns amounts and the fleet, equal states have equal
+// checksums
+template<typename GraphType>
+uint64_t GetStateChecksum(const BasicTrafficManager<GraphType>& manager) {
+  uint64_t checksum = 14695981039346656037ULL;
+  auto add = [&checksum](int value) {
+    for (int byte = 0; byte < 4; ++byte) {
+      checksum ^= (static_cast<uint32_t>(value) >> (8 * byte)) & 0xFF;
+      checksum *= 1099511628211ULL;
+    }
+  };
+  for (int value : manager.GetBunsAmounts()) {
+    add(value);
+  }
+  for (int value : manager.GetFleet()) {
+    add(value);
+  }
+  return checksum;
+}
+
+// forwards calls to the manager and records them into a trace, vehicle types
+// are recorded, unless all vehicles are of one type with 'vehicle_capacity'
+// and multiplier 1
+class TraceRecorder {
+ public:
+  TraceRecorder(TrafficManager* traffic_manager, int vehicle_capacity);
+
+  int MoveVehicles(int from, int to, int count);
+  int Transport(int from, int to, int buns_amount);
+  int TransportWithReturns(int from, int to, int buns_amount);
+
+  void SetBunsAmounts(std::vector<int> buns_amounts);
+  void SetVehicles(std::vector<int> vehicles);
+  void SetFleet(std::vector<int> fleet);
+  void SetBunsAmount(int town, int buns_amount);
+  void SetVehicle(int town, int vehicle);
+
+  const Trace& GetTrace() const;
+
+ private:
+  int Record(TraceOperation operation);
+
+  TrafficManager* traffic_manager_;
+  Trace trace_;
+};
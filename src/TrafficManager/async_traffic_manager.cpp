@@ -0,0 +1,113 @@
+#include "async_traffic_manager.h"
+
+#include "../Graphs/Chain/chain.h"
+#include "../Graphs/Clique/clique.h"
+#include "../Graphs/Composite/composite.h"
+#include "../Graphs/Graph/graph.h"
+#include "../Graphs/Grid/grid.h"
+#include "../Graphs/Ring/ring.h"
+#include "../Graphs/Tree/tree.h"
+
+template<typename GraphType>
+BasicAsyncTrafficManager<GraphType>::BasicAsyncTrafficManager(
+    BasicTrafficManager<GraphType>* traffic_manager,
+    executor::Executor* executor,
+    executor::Executor* resume_executor)
+    : traffic_manager_(traffic_manager),
+      executor_(executor ? executor : &executor::GetDefaultExecutor()),
+      resume_executor_(resume_executor ? resume_executor
+                                       : &executor::GetDefaultExecutor()),
+      strand_(executor_) {}
+
+template<typename GraphType>
+executor::Async<std::optional<int>>
+BasicAsyncTrafficManager<GraphType>::Transport(int from,
+                                               int to,
+                                               int buns_amount,
+                                               std::stop_token stop_token) {
+  return Run(&strand_,
+             [=, this] {
+               return traffic_manager_->Transport(from, to, buns_amount);
+             },
+             std::move(stop_token), true);
+}
+
+template<typename GraphType>
+executor::Async<std::optional<int>>
+BasicAsyncTrafficManager<GraphType>::TransportWithReturns(
+    int from,
+    int to,
+    int buns_amount,
+    std::stop_token stop_token) {
+  return Run(&strand_,
+             [=, this] {
+               return traffic_manager_->TransportWithReturns(from, to,
+                                                             buns_amount);
+             },
+             std::move(stop_token), true);
+}
+
+template<typename GraphType>
+executor::Async<std::optional<int>>
+BasicAsyncTrafficManager<GraphType>::MoveVehicles(int from,
+                                                  int to,
+                                                  int count,
+                                                  std::stop_token stop_token) {
+  return Run(&strand_,
+             [=, this] {
+               return traffic_manager_->MoveVehicles(from, to, count);
+             },
+             std::move(stop_token), true);
+}
+
+template<typename GraphType>
+executor::Async<std::optional<std::vector<AbstractGraph::Edge>>>
+BasicAsyncTrafficManager<GraphType>::GetShortestPath(
+    int from,
+    int to,
+    std::stop_token stop_token) {
+  return Run(executor_,
+             [=, this] {
+               return traffic_manager_->GetGraph()->GetShortestPath(from, to);
+             },
+             std::move(stop_token), false);
+}
+
+template<typename GraphType>
+template<typename Operation>
+executor::Async<std::optional<std::invoke_result_t<Operation>>>
+BasicAsyncTrafficManager<GraphType>::Run(executor::Executor* executor,
+                                         Operation operation,
+                                         std::stop_token stop_token,
+                                         bool changes_manager) {
+  co_await executor::Schedule(*executor);
+  std::optional<std::invoke_result_t<Operation>> result;
+  if (!stop_token.stop_requested()) {
+    std::vector<int> buns_amounts;
+    std::vector<int> fleet;
+    bool is_saved = changes_manager && stop_token.stop_possible();
+    if (is_saved) {
+      buns_amounts = traffic_manager_->GetBunsAmounts();
+      fleet = traffic_manager_->GetFleet();
+    }
+    result = operation();
+    if (stop_token.stop_requested()) {
+      result.reset();
+      if (is_saved) {
+        traffic_manager_->SetBunsAmounts(std::move(buns_amounts));
+        traffic_manager_->SetFleet(std::move(fleet));
+      }
+    }
+  }
+  co_await executor::Schedule(*resume_executor_);
+  co_return result;
+}
+
+template class BasicAsyncTrafficManager<AbstractGraph>;
+template class BasicAsyncTrafficManager<Graph>;
+template class BasicAsyncTrafficManager<Clique>;
+template class BasicAsyncTrafficManager<Chain>;
+template class BasicAsyncTrafficManager<Tree>;
+template class BasicAsyncTrafficManager<Ring>;
+template class BasicAsyncTrafficManager<Grid>;
+template class BasicAsyncTrafficManager<Composite>;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <optional>
+#include <stop_token>
+#include <type_traits>
+#include <vector>
+
+#include "../Executor/async.h"
+#include "../Executor/executor.h"
+#include "traffic_manager.h"
+
+// Coroutine interface of BasicTrafficManager for event loop based services:
+// operations run on a worker executor, awaiting coroutines are resumed on
+// 'resume_executor', e.g. the event loop, so it's never blocked by searches.
+// Operations, which change the manager, run one at a time in order, in which
+// they are awaited, by the same code as synchronous calls, so their results
+// are the same as of these calls in that order. The manager must not be used
+// directly, while some of them are not finished.
+// An operation, whose stop is requested before it finishes, doesn't change
+// anything and returns std::nullopt: the state of the manager is saved before
+// operations with a stoppable token and restored, if stop is requested during
+// them, which costs a copy of buns amounts and the fleet.
+template<typename GraphType>
+class BasicAsyncTrafficManager {
+ public:
+  // nullptr executors mean executor::GetDefaultExecutor()
+  explicit BasicAsyncTrafficManager(
+      BasicTrafficManager<GraphType>* traffic_manager,
+      executor::Executor* executor = nullptr,
+      executor::Executor* resume_executor = nullptr);
+
+  executor::Async<std::optional<int>> Transport(
+      int from, int to, int buns_amount, std::stop_token stop_token = {});
+  executor::Async<std::optional<int>> TransportWithReturns(
+      int from, int to, int buns_amount, std::stop_token stop_token = {});
+  executor::Async<std::optional<int>> MoveVehicles(
+      int from, int to, int count, std::stop_token stop_token = {});
+
+  // doesn't change the manager, so runs concurrently with other operations
+  executor::Async<std::optional<std::vector<AbstractGraph::Edge>>>
+  GetShortestPath(int from, int to, std::stop_token stop_token = {});
+
+ private:
+  // runs 'operation' on 'executor' unless stop is requested, then resumes on
+  // 'resume_executor_'; changes of the manager by it are undone, if stop is
+  // requested during it
+  template<typename Operation>
+  executor::Async<std::optional<std::invoke_result_t<Operation>>> Run(
+      executor::Executor* executor,
+      Operation operation,
+      std::stop_token stop_token,
+      bool changes_manager);
+
+  BasicTrafficManager<GraphType>* traffic_manager_;
+  executor::Executor* executor_;
+  executor::Executor* resume_executor_;
+  // operations, which change the manager
+  executor::Strand strand_;
+};
+
+using AsyncTrafficManager = BasicAsyncTrafficManager<AbstractGraph>;
@@ -1,223 +1,856 @@
 #include "traffic_manager.h"
 
+#include <algorithm>
 #include <cassert>
-#include <cmath>
+#include <cstdint>
 #include <numeric>
-#include <set>
-#include <unordered_map>
+#include <span>
 
-TrafficManager::TrafficManager(
-    const AbstractGraph* graph,
+#include "../Graphs/Algorithms/algorithms.h"
+#include "../Graphs/Algorithms/min_cost_flow.h"
+#include "../Graphs/Algorithms/vehicle_routing.h"
+#include "../Graphs/Chain/chain.h"
+#include "../Graphs/Clique/clique.h"
+#include "../Graphs/Composite/composite.h"
+#include "../Graphs/Graph/graph.h"
+#include "../Graphs/Grid/grid.h"
+#include "../Graphs/Ring/ring.h"
+#include "../Graphs/Tree/tree.h"
+#include "../Metrics/metrics.h"
+
+namespace {
+
+template<typename GraphType>
+const Tree* AsTree(const GraphType* graph) {
+  if constexpr (std::is_same_v<GraphType, Tree>) {
+    return graph;
+  } else if constexpr (std::is_same_v<GraphType, AbstractGraph>) {
+    return dynamic_cast<const Tree*>(graph);
+  } else {
+    return nullptr;
+  }
+}
+
+// distances may be int64_t (see Graph::DistanceWidth), times are int, so
+// they saturate at algorithms::kInf
+int GetTravelTime(int64_t distance, int time_multiplier) {
+  if (time_multiplier != 0 &&
+      distance >= algorithms::kInf / time_multiplier) {
+    return algorithms::kInf;
+  }
+  return static_cast<int>(distance * time_multiplier);
+}
+
+}  // namespace
+
+template<typename GraphType>
+BasicTrafficManager<GraphType>::BasicTrafficManager(
+    const GraphType* graph,
     std::vector<int> buns_amounts,
     std::vector<int> vehicles,
     int vehicle_capacity) :
     graph_(graph),
     buns_amounts_(std::move(buns_amounts)),
-    vehicles_(std::move(vehicles)),
-    vehicle_capacity_(vehicle_capacity) {
-  total_buns_amount_ =
-      std::accumulate(buns_amounts_.begin(), buns_amounts_.end(), 0);
+    vehicle_types_({{vehicle_capacity, 1}}),
+    fleet_(std::move(vehicles)),
+    tree_(AsTree(graph)) {
+  total_buns_amount_ = std::accumulate(
+      buns_amounts_.begin(), buns_amounts_.end(), int64_t{0});
+  InitFleet();
+}
+
+template<typename GraphType>
+BasicTrafficManager<GraphType>::BasicTrafficManager(
+    const GraphType* graph,
+    std::vector<int> buns_amounts,
+    std::vector<VehicleType> vehicle_types,
+    std::vector<int> fleet) :
+    graph_(graph),
+    buns_amounts_(std::move(buns_amounts)),
+    vehicle_types_(std::move(vehicle_types)),
+    fleet_(std::move(fleet)),
+    tree_(AsTree(graph)) {
+  total_buns_amount_ = std::accumulate(
+      buns_amounts_.begin(), buns_amounts_.end(), int64_t{0});
+  InitFleet();
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::InitFleet() {
+  int types_count = vehicle_types_.size();
+  assert(types_count > 0);
+  assert(fleet_.size() % types_count == 0);
+  // vehicles of zero capacity carry no buns, so they are left out of
+  // counts of vehicles for buns, which divide by capacities
+  vehicle_capacity_ = 0;
+  for (const auto& [capacity, time_multiplier] : vehicle_types_) {
+    assert(capacity >= 0 && time_multiplier > 0);
+    if (capacity > 0 &&
+        (vehicle_capacity_ == 0 || capacity < vehicle_capacity_)) {
+      vehicle_capacity_ = capacity;
+    }
+  }
+
+  types_by_speed_.resize(types_count);
+  std::iota(types_by_speed_.begin(), types_by_speed_.end(), 0);
+  types_by_capacity_ = types_by_speed_;
+  std::stable_sort(types_by_speed_.begin(), types_by_speed_.end(),
+                   [this](int lhs, int rhs) {
+                     const auto& lhs_type = vehicle_types_[lhs];
+                     const auto& rhs_type = vehicle_types_[rhs];
+                     return std::pair(lhs_type.time_multiplier,
+                                      -lhs_type.capacity) <
+                         std::pair(rhs_type.time_multiplier,
+                                   -rhs_type.capacity);
+                   });
+  auto is_empty_type = [this](int type) {
+    return vehicle_types_[type].capacity == 0;
+  };
+  carrying_types_by_speed_ = types_by_speed_;
+  std::erase_if(carrying_types_by_speed_, is_empty_type);
+  std::erase_if(types_by_capacity_, is_empty_type);
+  std::stable_sort(types_by_capacity_.begin(), types_by_capacity_.end(),
+                   [this](int lhs, int rhs) {
+                     return vehicle_types_[lhs].capacity >
+                         vehicle_types_[rhs].capacity;
+                   });
+
+  vehicles_.assign(fleet_.size() / types_count, 0);
+  for (int town = 0; town < vehicles_.size(); ++town) {
+    for (int type = 0; type < types_count; ++type) {
+      vehicles_[town] += fleet_[town * types_count + type];
+    }
+  }
   total_vehicles_ =
-      std::accumulate(vehicles_.begin(), vehicles_.end(), 0);
+      std::accumulate(vehicles_.begin(), vehicles_.end(), int64_t{0});
+  InitVehicleTowns();
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::InitVehicleTowns() {
+  vehicle_towns_.clear();
+  vehicle_town_indices_.clear();
+  if (landmarks_) {
+    vehicle_town_indices_.assign(vehicles_.size(), -1);
+  }
+  if (tree_) {
+    tree_vehicles_.Assign(vehicles_.size());
+  }
+  for (int town = 0; town < vehicles_.size(); ++town) {
+    UpdateVehicleTown(town, vehicles_[town]);
+  }
 }
 
-const std::vector<int>& TrafficManager::GetBunsAmounts() const {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::UpdateVehicleTown(int town, int delta) {
+  if (tree_) {
+    tree_vehicles_.Add(tree_->GetPreorderIndex(town), delta);
+  }
+  if (!landmarks_) {
+    return;
+  }
+  int& index = vehicle_town_indices_[town];
+  if (vehicles_[town] > 0 && index == -1) {
+    index = vehicle_towns_.size();
+    vehicle_towns_.push_back(town);
+  } else if (vehicles_[town] == 0 && index != -1) {
+    vehicle_town_indices_[vehicle_towns_.back()] = index;
+    vehicle_towns_[index] = vehicle_towns_.back();
+    vehicle_towns_.pop_back();
+    index = -1;
+  }
+}
+
+template<typename GraphType>
+const GraphType* BasicTrafficManager<GraphType>::GetGraph() const {
+  return graph_;
+}
+
+template<typename GraphType>
+const std::vector<int>&
+BasicTrafficManager<GraphType>::GetBunsAmounts() const {
   return buns_amounts_;
 }
 
-const std::vector<int>& TrafficManager::GetVehicles() const {
+template<typename GraphType>
+const std::vector<int>& BasicTrafficManager<GraphType>::GetVehicles() const {
   return vehicles_;
 }
 
-int TrafficManager::GetBunsAmount(int town) const {
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::GetBunsAmount(int town) const {
   assert(0 <= town && town < buns_amounts_.size());
   return buns_amounts_[town];
 }
 
-int TrafficManager::GetVehicle(int town) const {
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::GetVehicle(int town) const {
   assert(0 <= town && town < vehicles_.size());
   return vehicles_[town];
 }
 
-int TrafficManager::GetTotalBunsAmount() const {
+template<typename GraphType>
+const std::vector<typename BasicTrafficManager<GraphType>::VehicleType>&
+BasicTrafficManager<GraphType>::GetVehicleTypes() const {
+  return vehicle_types_;
+}
+
+template<typename GraphType>
+const std::vector<int>& BasicTrafficManager<GraphType>::GetFleet() const {
+  return fleet_;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::GetVehicle(int town, int type) const {
+  assert(0 <= town && town < vehicles_.size());
+  assert(0 <= type && type < vehicle_types_.size());
+  return fleet_[town * vehicle_types_.size() + type];
+}
+
+template<typename GraphType>
+int64_t BasicTrafficManager<GraphType>::GetTotalBunsAmount() const {
   return total_buns_amount_;
 }
 
-int TrafficManager::GetTotalVehicles() const {
+template<typename GraphType>
+int64_t BasicTrafficManager<GraphType>::GetTotalVehicles() const {
   return total_vehicles_;
 }
 
-void TrafficManager::SetBunsAmounts(std::vector<int> buns_amounts) {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetBunsAmounts(
+    std::vector<int> buns_amounts) {
   buns_amounts_ = std::move(buns_amounts);
-  total_buns_amount_ =
-      std::accumulate(buns_amounts_.begin(), buns_amounts_.end(), 0);
+  total_buns_amount_ = std::accumulate(
+      buns_amounts_.begin(), buns_amounts_.end(), int64_t{0});
 }
 
-void TrafficManager::SetVehicles(std::vector<int> vehicles) {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetVehicles(std::vector<int> vehicles) {
+  int types_count = vehicle_types_.size();
+  fleet_.assign(vehicles.size() * types_count, 0);
+  for (int town = 0; town < vehicles.size(); ++town) {
+    fleet_[town * types_count] = vehicles[town];
+  }
   vehicles_ = std::move(vehicles);
   total_vehicles_ =
-      std::accumulate(vehicles_.begin(), vehicles_.end(), 0);
+      std::accumulate(vehicles_.begin(), vehicles_.end(), int64_t{0});
+  InitVehicleTowns();
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetFleet(std::vector<int> fleet) {
+  fleet_ = std::move(fleet);
+  InitFleet();
 }
 
-void TrafficManager::SetBunsAmount(int town, int buns_amount) {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetBunsAmount(int town,
+                                                   int buns_amount) {
   assert(0 <= town && town < buns_amounts_.size());
   total_buns_amount_ -= buns_amounts_[town];
   total_buns_amount_ += buns_amount;
   buns_amounts_[town] = buns_amount;
 }
 
-void TrafficManager::SetVehicle(int town, int vehicle) {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetVehicle(int town, int vehicle) {
   assert(0 <= town && town < vehicles_.size());
   total_vehicles_ -= vehicles_[town];
   total_vehicles_ += vehicle;
+  int delta = vehicle - vehicles_[town];
   vehicles_[town] = vehicle;
+  int types_count = vehicle_types_.size();
+  std::fill_n(fleet_.begin() + town * types_count, types_count, 0);
+  fleet_[town * types_count] = vehicle;
+  UpdateVehicleTown(town, delta);
 }
 
-int TrafficManager::MoveVehicles(int from, int to, int count) {
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetExecutor(
+    executor::Executor* executor) {
+  executor_ = executor;
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetLandmarks(
+    const algorithms::Landmarks* landmarks) {
+  assert(!landmarks || landmarks->GetSize() == vehicles_.size());
+  landmarks_ = landmarks;
+  InitVehicleTowns();
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::SetHubLabels(
+    const algorithms::HubLabels* hub_labels) {
+  assert(!hub_labels || hub_labels->GetSize() == vehicles_.size());
+  hub_labels_ = hub_labels;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::MoveVehicles(int from, int to, int count) {
   assert(0 <= from && from < vehicles_.size());
   assert(0 <= to && to < vehicles_.size());
   if (count == 0) {
     return 0;
   }
+  int time_multiplier = TakeVehicles(from, to, count);
+  return GetTravelTime(GetDistance(from, to), time_multiplier);
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::MoveVehiclesOfType(int from,
+                                                        int to,
+                                                        int type,
+                                                        int count) {
+  int types_count = vehicle_types_.size();
+  count = std::min(count, fleet_[from * types_count + type]);
+  fleet_[from * types_count + type] -= count;
+  fleet_[to * types_count + type] += count;
   vehicles_[from] -= count;
   vehicles_[to] += count;
-  return GetLenForPath(graph_->GetShortestPath(from, to));
+  UpdateVehicleTown(from, -count);
+  UpdateVehicleTown(to, count);
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::TakeVehicles(int from,
+                                                 int to,
+                                                 int count,
+                                                 bool carrying_only) {
+  int types_count = vehicle_types_.size();
+  int time_multiplier = 0;
+  for (int type : carrying_only ? carrying_types_by_speed_
+                                : types_by_speed_) {
+    if (count == 0) {
+      break;
+    }
+    int move_count = std::min(count, fleet_[from * types_count + type]);
+    if (move_count > 0) {
+      MoveVehiclesOfType(from, to, type, move_count);
+      count -= move_count;
+      time_multiplier = std::max(time_multiplier,
+                                 vehicle_types_[type].time_multiplier);
+    }
+  }
+  return time_multiplier;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::GetCapacity(int town) const {
+  int types_count = vehicle_types_.size();
+  int capacity = 0;
+  for (int type = 0; type < types_count; ++type) {
+    capacity += fleet_[town * types_count + type] *
+        vehicle_types_[type].capacity;
+  }
+  return capacity;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::GetCarryingVehicles(int town) const {
+  int types_count = vehicle_types_.size();
+  int count = 0;
+  for (int type : types_by_capacity_) {
+    count += fleet_[town * types_count + type];
+  }
+  return count;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::MoveVehiclesForBuns(int from,
+                                                        int to,
+                                                        int buns_amount) {
+  if (buns_amount == 0) {
+    return 0;
+  }
+  // the slowest vehicles needed are as fast as possible: types are added
+  // from the fastest ones, until they can carry all buns
+  int types_count = vehicle_types_.size();
+  const int* town_fleet = fleet_.data() + from * types_count;
+  int max_time_multiplier = 0;
+  int capacity = 0;
+  for (int type : carrying_types_by_speed_) {
+    if (capacity >= buns_amount) {
+      break;
+    }
+    capacity += town_fleet[type] * vehicle_types_[type].capacity;
+    max_time_multiplier = vehicle_types_[type].time_multiplier;
+  }
+
+  // fewest vehicles among fast enough ones are the largest of them
+  int time_multiplier = 0;
+  for (int type : types_by_capacity_) {
+    const auto& vehicle_type = vehicle_types_[type];
+    if (buns_amount <= 0) {
+      break;
+    }
+    if (vehicle_type.time_multiplier > max_time_multiplier) {
+      continue;
+    }
+    int move_count = std::min(
+        town_fleet[type],
+        (buns_amount + vehicle_type.capacity - 1) / vehicle_type.capacity);
+    if (move_count > 0) {
+      MoveVehiclesOfType(from, to, type, move_count);
+      buns_amount -= move_count * vehicle_type.capacity;
+      time_multiplier =
+          std::max(time_multiplier, vehicle_type.time_multiplier);
+    }
+  }
+  if (time_multiplier == 0) {
+    return 0;
+  }
+  return GetTravelTime(GetDistance(from, to), time_multiplier);
 }
 
-int TrafficManager::Transport(int from, int to, int buns_amount) {
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::Transport(int from,
+                                              int to,
+                                              int buns_amount) {
   assert(0 <= from && from < vehicles_.size());
   assert(0 <= to && to < vehicles_.size());
   assert(buns_amounts_[from] >= buns_amount);
-  int vehicles_needed = buns_amount / vehicle_capacity_;
-  if (buns_amount % vehicle_capacity_ != 0) {
-    ++vehicles_needed;
-  }
-
+  METRICS_SCOPED_TIMER(kTransportNs);
   int result = 0;
-  if (vehicles_needed - vehicles_[from] > 0) {
-    result = MoveClosestVehicles(from, vehicles_needed - vehicles_[from]);
+  int capacity = GetCapacity(from);
+  if (buns_amount > capacity) {
+    METRICS_ADD(kTransportFallbacks, 1);
+    result = MoveClosestVehicles(from, 0, buns_amount - capacity);
   }
-  result += MoveVehicles(from, to, vehicles_needed);
+  result = algorithms::SaturatingAdd(
+      result, MoveVehiclesForBuns(from, to, buns_amount));
   MoveBuns(from, to, buns_amount);
   return result;
 }
 
-namespace {
-struct PathToTownInfo {
-  int length{0};
-  int town_index{0};
-
-  std::strong_ordering operator<=>(
-      const PathToTownInfo& path_to_town_info) const = default;
-};
-}
-
-int TrafficManager::MoveClosestVehicles(int to, int count) {
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::MoveClosestVehicles(int to,
+                                                        int count,
+                                                        int capacity) {
+  METRICS_SCOPED_TIMER(kMoveClosestVehiclesNs);
+  METRICS_ADD(kMoveClosestVehiclesCalls, 1);
   int res = 0;
-  std::set<PathToTownInfo> towns;
-  towns.insert({0, to});
-  std::unordered_map<int, int> distance;
-  distance[to] = 0;
-
-  while (count > 0 && !towns.empty()) {
-    auto begin_it = towns.begin();
-    int town_index = begin_it->town_index;
-    towns.erase(begin_it);
-
-    int cur_move_count = std::min(vehicles_[town_index], count);
-    res = MoveVehicles(town_index, to, cur_move_count);
-    count -= cur_move_count;
-    for (auto[next_node, len] : graph_->GetEdges(town_index)) {
-      bool can_update_existing = false;
-      if (distance.contains(next_node) &&
-          distance[next_node] > len + distance[town_index]) {
-        can_update_existing = true;
-      }
-      if (can_update_existing) {
-        towns.erase({distance[next_node], next_node});
+  if (count <= 0 && capacity <= 0) {
+    return res;
+  }
+  int types_count = vehicle_types_.size();
+  auto visitor = [&](int town_index, int distance) {
+    if (town_index == to || vehicles_[town_index] == 0) {
+      return true;
+    }
+    for (int type : carrying_types_by_speed_) {
+      const auto& vehicle_type = vehicle_types_[type];
+      int needed_count = std::max(
+          count,
+          (capacity + vehicle_type.capacity - 1) / vehicle_type.capacity);
+      int cur_move_count =
+          std::min(fleet_[town_index * types_count + type], needed_count);
+      if (cur_move_count <= 0) {
+        continue;
       }
-      if (!distance.contains(next_node) || can_update_existing) {
-        distance[next_node] = distance[town_index] + len;
-        towns.insert({distance[next_node], next_node});
+      MoveVehiclesOfType(town_index, to, type, cur_move_count);
+      count -= cur_move_count;
+      capacity -= cur_move_count * vehicle_type.capacity;
+      // vehicles go along the shortest path, which length is known
+      res = std::max(res,
+                     GetTravelTime(distance, vehicle_type.time_multiplier));
+    }
+    return count > 0 || capacity > 0;
+  };
+
+  // On a tree parts without vehicles aren't searched at all.
+  // Bounds of distances to towns with vehicles are computed from all their
+  // landmark distances, so they help only while these towns are few (then
+  // they are usually far away). Towns with vehicles are reached in order of
+  // distance either way, equally far ones may be reached in another order.
+  const int kMaxGoalTowns = 64;
+  if (tree_) {
+    tree_->VisitClosestVertices(to, visitor, [this](int begin, int end) {
+      return tree_vehicles_.GetSum(begin, end);
+    });
+  } else if (landmarks_ && landmarks_->GetCount() > 0 &&
+      vehicle_towns_.size() <= kMaxGoalTowns) {
+    std::vector<int> goals;
+    for (int town : vehicle_towns_) {
+      if (town != to) {
+        goals.push_back(town);
       }
     }
+    algorithms::GoalDirectedSearch(
+        *graph_, to, algorithms::LandmarksPotential(*landmarks_, goals),
+        visitor);
+  } else {
+    algorithms::VisitClosestVertices(*graph_, to, visitor);
   }
   return res;
 }
 
-int TrafficManager::GetLenForPath(
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::DispatchVehicles(
+    const std::vector<int>& vehicles_needed) {
+  return DispatchVehicles(vehicles_needed, nullptr);
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::DispatchVehicles(
+    const std::vector<int>& vehicles_needed,
+    std::vector<int>* arrival_times) {
+  int n = vehicles_.size();
+  assert(vehicles_needed.size() == n);
+  if (arrival_times) {
+    arrival_times->assign(n, 0);
+  }
+
+  std::vector<int> deficits(n);
+  std::vector<int> surpluses(n);
+  int64_t total_surplus = 0;
+  for (int town = 0; town < n; ++town) {
+    int vehicles = GetCarryingVehicles(town);
+    deficits[town] = std::max(0, vehicles_needed[town] - vehicles);
+    surpluses[town] = std::max(0, vehicles - vehicles_needed[town]);
+    total_surplus += surpluses[town];
+  }
+
+  // Every round searches from all towns lacking vehicles at once, so every
+  // town with extra vehicles is reached from the closest of them and gives
+  // its vehicles to it. Towns lacking vehicles stop expanding their part of
+  // the search, when they have enough, towns reached only through them wait
+  // for the next round with the remaining ones.
+  // When a round covers less than half of the deficits, the rest are mostly
+  // walled in by covered ones, and they are searched from one at a time, so
+  // the same parts of the graph aren't explored round after round. A search
+  // from one town ends, when it has enough or no more vehicles are reachable,
+  // so the town is dropped after it. A round of all towns, which moves no
+  // vehicles, means that no extra vehicles are reachable from any of them
+  // (e.g. they are in other components of the graph).
+  std::vector<int> sources;
+  for (int town = 0; town < n; ++town) {
+    if (deficits[town] > 0) {
+      sources.push_back(town);
+    }
+  }
+  std::vector<int> closest_source(n);
+  bool one_at_a_time = false;
+  int result = 0;
+  while (total_surplus > 0 && !sources.empty()) {
+    std::span<const int> round_sources = sources;
+    if (one_at_a_time) {
+      round_sources = round_sources.first(1);
+    }
+    int64_t round_deficit = 0;
+    for (int source : round_sources) {
+      round_deficit += deficits[source];
+    }
+    int64_t initial_round_deficit = round_deficit;
+    algorithms::SearchWorkspace& tree =
+        algorithms::SearchWorkspace::GetThreadLocal();
+    algorithms::MultiSourceDijkstra(
+        *graph_, round_sources, [&](int town, int distance) {
+          int ancestor = tree.GetAncestor(town);
+          closest_source[town] =
+              (ancestor == -1) ? town : closest_source[ancestor];
+          int source = closest_source[town];
+          if (deficits[source] == 0) {
+            return algorithms::VisitAction::kSkipEdges;
+          }
+          int move_count = std::min(surpluses[town], deficits[source]);
+          if (move_count == 0) {
+            return algorithms::VisitAction::kContinue;
+          }
+          surpluses[town] -= move_count;
+          deficits[source] -= move_count;
+          round_deficit -= move_count;
+          total_surplus -= move_count;
+          // vehicles go along the shortest path, which length is known
+          int arrival_time = GetTravelTime(
+              distance, TakeVehicles(town, source, move_count, true));
+          result = std::max(result, arrival_time);
+          if (arrival_times) {
+            (*arrival_times)[source] =
+                std::max((*arrival_times)[source], arrival_time);
+          }
+          return (total_surplus > 0 && round_deficit > 0)
+                 ? algorithms::VisitAction::kContinue
+                 : algorithms::VisitAction::kStop;
+        }, &tree);
+
+    if (one_at_a_time) {
+      sources.erase(sources.begin());
+      continue;
+    }
+    if (round_deficit == initial_round_deficit) {
+      break;
+    }
+    int covered_count = std::erase_if(sources, [&deficits](int town) {
+      return deficits[town] == 0;
+    });
+    if (2 * covered_count < round_sources.size()) {
+      one_at_a_time = true;
+    }
+  }
+  return result;
+}
+
+template<typename GraphType>
+std::vector<int> BasicTrafficManager<GraphType>::TransportBatch(
+    const std::vector<Order>& orders) {
+  std::vector<int> vehicles_needed(vehicles_.size(), 0);
+  std::vector<int> buns_needed(buns_amounts_.size(), 0);
+  for (const auto& [from, to, buns_amount] : orders) {
+    assert(0 <= from && from < vehicles_.size());
+    assert(0 <= to && to < vehicles_.size());
+    assert(vehicle_capacity_ > 0);
+    vehicles_needed[from] +=
+        (buns_amount + vehicle_capacity_ - 1) / vehicle_capacity_;
+    buns_needed[from] += buns_amount;
+    assert(buns_amounts_[from] >= buns_needed[from]);
+  }
+
+  std::vector<int> arrival_times;
+  DispatchVehicles(vehicles_needed, &arrival_times);
+
+  std::vector<int> result;
+  result.reserve(orders.size());
+  for (const auto& [from, to, buns_amount] : orders) {
+    int vehicles_count =
+        (buns_amount + vehicle_capacity_ - 1) / vehicle_capacity_;
+    int time_multiplier = TakeVehicles(from, to, vehicles_count, true);
+    result.push_back(algorithms::SaturatingAdd(
+        arrival_times[from],
+        GetTravelTime(GetDistance(from, to), time_multiplier)));
+    MoveBuns(from, to, buns_amount);
+  }
+  return result;
+}
+
+template<typename GraphType>
+std::vector<typename BasicTrafficManager<GraphType>::Order>
+BasicTrafficManager<GraphType>::Redistribute(
+    const std::vector<int>& target_buns_amounts) {
+  assert(target_buns_amounts.size() == buns_amounts_.size());
+  std::vector<int> supplies(buns_amounts_.size());
+  for (int town = 0; town < supplies.size(); ++town) {
+    supplies[town] = buns_amounts_[town] - target_buns_amounts[town];
+  }
+
+  std::vector<Order> orders;
+  for (const auto& [from, to, amount] :
+      algorithms::GetMinCostTransportation(*graph_, supplies)) {
+    orders.push_back({from, to, amount});
+  }
+  TransportBatch(orders);
+  return orders;
+}
+
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::TransportWithTours(
+    int from,
+    const std::vector<Delivery>& deliveries) {
+  assert(0 <= from && from < vehicles_.size());
+  // index of delivery in the distance matrix is its index plus one
+  std::vector<int> towns = {from};
+  std::vector<int> tour_loads = {0};
+  int buns_needed = 0;
+  for (const auto& [to, buns_amount] : deliveries) {
+    assert(0 <= to && to < vehicles_.size());
+    assert(vehicle_capacity_ > 0);
+    towns.push_back(to);
+    tour_loads.push_back(buns_amount % vehicle_capacity_);
+    buns_needed += buns_amount;
+  }
+  assert(buns_amounts_[from] >= buns_needed);
+
+  auto distances = hub_labels_
+      ? algorithms::DistanceMatrix(std::move(towns),
+                                   [this](int from, int to) {
+                                     return hub_labels_->GetDistance(from, to);
+                                   })
+      : algorithms::DistanceMatrix(*graph_, std::move(towns), executor_);
+  auto tours = algorithms::PlanTours(distances, tour_loads, vehicle_capacity_);
+  int vehicles_needed = tours.size();
+  int result = 0;
+  for (int i = 0; i < deliveries.size(); ++i) {
+    if (distances.GetDistance(0, i + 1) == algorithms::kInf) {
+      // never done, its buns stay in 'from'
+      result = algorithms::kInf;
+    } else {
+      vehicles_needed += deliveries[i].buns_amount / vehicle_capacity_;
+    }
+  }
+
+  int start_time =
+      MoveClosestVehicles(from, vehicles_needed - GetCarryingVehicles(from));
+  for (int i = 0; i < deliveries.size(); ++i) {
+    const auto& [to, buns_amount] = deliveries[i];
+    if (distances.GetDistance(0, i + 1) == algorithms::kInf) {
+      continue;
+    }
+    int vehicles_count = buns_amount / vehicle_capacity_;
+    if (vehicles_count > 0) {
+      int time_multiplier = TakeVehicles(from, to, vehicles_count, true);
+      result = std::max(
+          result,
+          algorithms::SaturatingAdd(
+              start_time,
+              GetTravelTime(distances.GetDistance(0, i + 1),
+                            time_multiplier)));
+    }
+    MoveBuns(from, to, buns_amount);
+  }
+  for (const auto& tour : tours) {
+    int time_multiplier =
+        TakeVehicles(from, distances.GetTown(tour.back()), 1, true);
+    result = std::max(
+        result,
+        algorithms::SaturatingAdd(
+            start_time,
+            GetTravelTime(algorithms::GetTourLength(distances, tour),
+                          time_multiplier)));
+  }
+  return result;
+}
+
+template<typename GraphType>
+int64_t BasicTrafficManager<GraphType>::GetLenForPath(
     const std::vector<AbstractGraph::Edge>& path) {
-  int total_len = 0;
+  int64_t total_len = 0;
   for (const auto&[_, len] : path) {
     total_len += len;
   }
   return total_len;
 }
 
-void TrafficManager::MoveBuns(int from, int to, int count) {
+template<typename GraphType>
+int64_t BasicTrafficManager<GraphType>::GetDistance(int from,
+                                                    int to) const {
+  int64_t distance;
+  if (hub_labels_) {
+    distance = hub_labels_->GetDistance(from, to);
+  } else if (tree_) {
+    distance = tree_->GetDistance(from, to);
+  } else if constexpr (requires { graph_->GetDistance(from, to); }) {
+    // every final class finds distances without paths, Graph may find
+    // int64_t ones
+    distance = graph_->GetDistance(from, to);
+    if (distance == algorithms::kInfDistance<decltype(
+        graph_->GetDistance(from, to))>) {
+      return 0;
+    }
+    return distance;
+  } else {
+    auto path = graph_->GetShortestPath(from, to);
+    METRICS_RECORD(kPathEdges, path.size());
+    return GetLenForPath(path);
+  }
+  return distance == algorithms::kInf ? 0 : distance;
+}
+
+template<typename GraphType>
+void BasicTrafficManager<GraphType>::MoveBuns(int from, int to, int count) {
   SetBunsAmount(from, buns_amounts_[from] - count);
   SetBunsAmount(to, buns_amounts_[to] + count);
 }
 
-bool TrafficManager::ArrivalAction::operator>(
-    TrafficManager::ArrivalAction arrival_action) const {
+template<typename GraphType>
+bool BasicTrafficManager<GraphType>::ArrivalAction::operator>(
+    ArrivalAction arrival_action) const {
   return timestamp > arrival_action.timestamp;
 }
 
-TrafficManager::ActionsQueue TrafficManager::InitActionsQueue(
+template<typename GraphType>
+typename BasicTrafficManager<GraphType>::ActionsQueue
+BasicTrafficManager<GraphType>::InitActionsQueue(
     int start_town,
     int finish_town,
     int main_path_len) const {
   ActionsQueue actions_queue;
   auto paths = graph_->GetShortestPaths(start_town);
+  int types_count = vehicle_types_.size();
+  // vehicles of zero capacity would make trips forever
+  for (int type = 0; type < types_count; ++type) {
+    if (vehicle_types_[type].capacity == 0) {
+      continue;
+    }
+    actions_queue.push({0,
+                        fleet_[start_town * types_count + type],
+                        start_town,
+                        start_town,
+                        type});
+  }
   int cur_town_index = 0;
-  actions_queue.push({0,
-                      vehicles_[start_town],
-                      start_town,
-                      start_town});
   for (const auto& path : paths) {
     if (cur_town_index != start_town) {
-      actions_queue.push({GetLenForPath(path) + main_path_len,
-                          vehicles_[cur_town_index],
-                          cur_town_index,
-                          finish_town});
+      int64_t path_len = GetLenForPath(path) + main_path_len;
+      for (int type = 0; type < types_count; ++type) {
+        if (vehicle_types_[type].capacity == 0) {
+          continue;
+        }
+        int arrival_time =
+            GetTravelTime(path_len, vehicle_types_[type].time_multiplier);
+        actions_queue.push({arrival_time,
+                            fleet_[cur_town_index * types_count + type],
+                            cur_town_index,
+                            finish_town,
+                            type});
+      }
     }
     ++cur_town_index;
   }
   return actions_queue;
 }
 
-int TrafficManager::TransportWithReturns(int from, int to, int buns_amount) {
+template<typename GraphType>
+int BasicTrafficManager<GraphType>::TransportWithReturns(int from,
+                                                         int to,
+                                                         int buns_amount) {
   assert(0 <= from && from < vehicles_.size());
   assert(0 <= to && to < vehicles_.size());
   assert(buns_amounts_[from] >= buns_amount);
+  METRICS_SCOPED_TIMER(kTransportWithReturnsNs);
   int result = 0;
-  int main_path_len = GetLenForPath(graph_->GetShortestPath(from, to));
+  int main_path_len = GetTravelTime(GetDistance(from, to), 1);
   auto actions_queue = InitActionsQueue(from, to, main_path_len);
-  int vehicles_needed = ceil(1. * buns_amount / vehicle_capacity_);
+  // vehicles arrive in order of time, so the fastest ones make more trips
+  int buns_left = buns_amount;
   while (!actions_queue.empty()) {
-    auto[timestamp, vehicles_count, cur_from, cur_to] = actions_queue.top();
+    auto[timestamp, vehicles_count, cur_from, cur_to, type] =
+        actions_queue.top();
     result = timestamp;
     actions_queue.pop();
-    MoveVehicles(cur_from, cur_to, vehicles_count);
+    MoveVehiclesOfType(cur_from, cur_to, type, vehicles_count);
+    const auto& vehicle_type = vehicle_types_[type];
+    int trip_time =
+        GetTravelTime(main_path_len, vehicle_type.time_multiplier);
     if (cur_to == from) {
-      actions_queue.push({timestamp + main_path_len,
+      actions_queue.push({algorithms::SaturatingAdd(timestamp, trip_time),
                           vehicles_count,
                           from,
-                          to});
+                          to,
+                          type});
     } else {
-      vehicles_needed -= vehicles_count;
-      if (vehicles_needed <= 0) {
-        int to_return = -vehicles_needed;
-        MoveVehicles(cur_to, cur_from, to_return);
+      buns_left -= vehicles_count * vehicle_type.capacity;
+      if (buns_left <= 0) {
+        int to_return = -buns_left / vehicle_type.capacity;
+        MoveVehiclesOfType(cur_to, cur_from, type, to_return);
         break;
       }
-      actions_queue.push({timestamp + main_path_len,
+      actions_queue.push({algorithms::SaturatingAdd(timestamp, trip_time),
                           vehicles_count,
                           to,
-                          from});
+                          from,
+                          type});
     }
   }
   MoveBuns(from, to, buns_amount);
   return result;
 }
+
+template class BasicTrafficManager<AbstractGraph>;
+template class BasicTrafficManager<Graph>;
+template class BasicTrafficManager<Clique>;
+template class BasicTrafficManager<Chain>;
+template class BasicTrafficManager<Tree>;
+template class BasicTrafficManager<Ring>;
+template class BasicTrafficManager<Grid>;
+template class BasicTrafficManager<Composite>;
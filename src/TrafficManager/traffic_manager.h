@@ -1,48 +1,172 @@
 #pragma once
 
-#include <vector>
+#include <cstdint>
 #include <queue>
+#include <type_traits>
+#include <vector>
 
+#include "../Executor/executor.h"
 #include "../Graphs/AbstractGraph/abstract_graph.h"
+#include "../Graphs/Algorithms/fenwick_tree.h"
+#include "../Graphs/Algorithms/hub_labels.h"
+#include "../Graphs/Algorithms/landmarks.h"
+
+class Tree;
+
+// GraphType is the static type of the graph the manager works with. When it
+// is a final class (Graph, Clique, Chain, Tree, Ring, Grid, Composite), graph
+// calls are resolved at compile time, BasicTrafficManager<AbstractGraph>
+// works with any graph through virtual calls. Methods are instantiated in
+// traffic_manager.cpp for AbstractGraph and every final graph class.
+// Final graphs give distances without paths, a Graph with
+// Graph::DistanceWidth::k64Bit gives ones longer than int, but times are int
+// and saturate at algorithms::kInf. On a Tree (also behind AbstractGraph)
+// searches for vehicles skip subtrees without them.
+template<typename GraphType>
+class BasicTrafficManager {
+  static_assert(std::is_base_of_v<AbstractGraph, GraphType>);
 
-class TrafficManager {
  public:
-  TrafficManager(
-      const AbstractGraph* graph,
+  struct VehicleType {
+    bool operator==(const VehicleType& rhs) const = default;
+
+    // vehicles of zero capacity are moved, but never carry buns
+    int capacity{1};
+    // travel time of the vehicle is length of its path multiplied by it, so
+    // slower vehicles have greater multipliers
+    int time_multiplier{1};
+  };
+
+  // all vehicles are of one type with 'vehicle_capacity' and multiplier 1
+  BasicTrafficManager(
+      const GraphType* graph,
       std::vector<int> buns_amounts,
       std::vector<int> vehicles,
       int vehicle_capacity);
+  // 'fleet[town * vehicle_types.size() + type]' is the number of vehicles of
+  // the type in the town
+  BasicTrafficManager(
+      const GraphType* graph,
+      std::vector<int> buns_amounts,
+      std::vector<VehicleType> vehicle_types,
+      std::vector<int> fleet);
 
+  const GraphType* GetGraph() const;
   const std::vector<int>& GetBunsAmounts() const;
   const std::vector<int>& GetVehicles() const;
   int GetBunsAmount(int town) const;
   int GetVehicle(int town) const;
+  const std::vector<VehicleType>& GetVehicleTypes() const;
+  const std::vector<int>& GetFleet() const;
+  int GetVehicle(int town, int type) const;
 
+  // vehicles set by count are of type 0, other types are removed from towns
   void SetBunsAmounts(std::vector<int> buns_amounts);
   void SetVehicles(std::vector<int> vehicles);
+  void SetFleet(std::vector<int> fleet);
   void SetBunsAmount(int town, int buns_amount);
   void SetVehicle(int town, int vehicle);
-
-  int GetTotalBunsAmount() const;
-  int GetTotalVehicles() const;
-
+  // executor for searches of batch methods, nullptr means
+  // executor::GetDefaultExecutor()
+  void SetExecutor(executor::Executor* executor);
+  // landmarks of the graph with its indices, e.g. Landmarks::Build(graph),
+  // the manager uses them for goal directed searches of vehicles, while few
+  // towns have them; nullptr turns it off
+  void SetLandmarks(const algorithms::Landmarks* landmarks);
+  // hub labels of the graph, e.g. HubLabels::Build(graph), are the source of
+  // distances between two towns instead of shortest path searches; nullptr
+  // turns it off
+  void SetHubLabels(const algorithms::HubLabels* hub_labels);
+
+  int64_t GetTotalBunsAmount() const;
+  int64_t GetTotalVehicles() const;
+
+  // moves at most 'count' vehicles, which are in 'from', the fastest ones
+  // first; returns time, when the slowest of them arrives
   int MoveVehicles(int from, int to, int count);
 
+  // vehicles for buns are chosen, so they arrive as soon as possible, and
+  // there are as few of them as possible
   int Transport(int from, int to, int buns_amount);
   int TransportWithReturns(int from, int to, int buns_amount);
 
+  // moves vehicles, which carry buns, from towns, which have more than they
+  // need, so every town has at least 'vehicles_needed[town]' of them (as far
+  // as there are enough vehicles), vehicles go to the closest towns lacking
+  // them; returns time, when the last vehicle arrives
+  int DispatchVehicles(const std::vector<int>& vehicles_needed);
+
+  struct Order {
+    int from{0};
+    int to{0};
+    int buns_amount{0};
+  };
+  // executes orders at the same time: missing vehicles are dispatched to
+  // all 'from' towns at once, then every order is executed like Transport;
+  // returns time of every order.
+  // Batch methods below count vehicles as if all of them had the smallest
+  // capacity of the fleet.
+  std::vector<int> TransportBatch(const std::vector<Order>& orders);
+
+  // moves buns, so every town has 'target_buns_amounts[town]' of them, with
+  // minimal total distance travelled by buns (vehicles are loaded fully, so
+  // it's proportional to the distance of vehicles); returns orders, which were
+  // executed by TransportBatch. Buns, which can't reach towns lacking them in
+  // a disconnected graph, stay where they are.
+  std::vector<Order> Redistribute(const std::vector<int>& target_buns_amounts);
+
+  struct Delivery {
+    int to{0};
+    int buns_amount{0};
+  };
+  // delivers buns from 'from' to several towns: full vehicle loads go
+  // straight to their towns, the rest are combined into tours, where one
+  // vehicle visits several towns and stays at the last of them; missing
+  // vehicles come to 'from' like in Transport; returns time, when the last
+  // delivery is done. Deliveries to towns unreachable from 'from' aren't
+  // done, their buns stay in 'from' and algorithms::kInf is returned.
+  int TransportWithTours(int from, const std::vector<Delivery>& deliveries);
+
  private:
   friend class TrafficManagerTester;
 
   void MoveBuns(int from, int to, int count);
-  int MoveClosestVehicles(int to, int count);
-  static int GetLenForPath(const std::vector<AbstractGraph::Edge>& path);
+  // moves closest vehicles, which carry buns, to 'to', until at least
+  // 'count' of them are moved and they can carry at least 'capacity' buns,
+  // vehicles of a town are taken the fastest first; returns time, when the
+  // last of them arrives
+  int MoveClosestVehicles(int to, int count, int capacity = 0);
+  // moves vehicles for buns from 'from' to 'to', as Transport chooses them;
+  // returns time, when the last of them arrives
+  int MoveVehiclesForBuns(int from, int to, int buns_amount);
+  // moves at most 'count' vehicles of the type, doesn't take time into account
+  void MoveVehiclesOfType(int from, int to, int type, int count);
+  // moves at most 'count' vehicles (only ones, which carry buns, if
+  // 'carrying_only' is set) the fastest first; returns the greatest time
+  // multiplier of moved vehicles, 0 if none were moved
+  int TakeVehicles(int from, int to, int count, bool carrying_only = false);
+  int GetCapacity(int town) const;
+  // number of vehicles of the town, which carry buns
+  int GetCarryingVehicles(int town) const;
+  void InitFleet();
+  // keep 'vehicle_towns_' (while there are landmarks) and 'tree_vehicles_'
+  // up to date, when vehicles of 'town' change by 'delta'
+  void InitVehicleTowns();
+  void UpdateVehicleTown(int town, int delta);
+  // fills time, when the last vehicle arrives to every town, if
+  // 'arrival_times' isn't nullptr
+  int DispatchVehicles(const std::vector<int>& vehicles_needed,
+                       std::vector<int>* arrival_times);
+  static int64_t GetLenForPath(const std::vector<AbstractGraph::Edge>& path);
+  // length of the shortest path, 0 if there is no path
+  int64_t GetDistance(int from, int to) const;
 
   struct ArrivalAction {
     int timestamp{0};
     int vehicles_amount{0};
     int from_town_index{0};
     int to_town_index{0};
+    int type{0};
 
     bool operator>(ArrivalAction arrival_action) const;
   };
@@ -56,13 +180,41 @@ class TrafficManager {
       int main_path_len) const;
 
  private:
-  const AbstractGraph* graph_;
+  const GraphType* graph_;
   std::vector<int> buns_amounts_;
+  // total number of vehicles in every town
   std::vector<int> vehicles_;
+  // smallest positive capacity of vehicle types, 0 if no type carries buns
   int vehicle_capacity_{0};
 
-  int total_buns_amount_{0};
-  int total_vehicles_{0};
+  std::vector<VehicleType> vehicle_types_;
+  // vehicles of town are stored together in town-major order, so searches
+  // read one cache line per town
+  std::vector<int> fleet_;
+  // type indices by increasing time multiplier, then decreasing capacity
+  std::vector<int> types_by_speed_;
+  // the same without types of zero capacity
+  std::vector<int> carrying_types_by_speed_;
+  // indices of types, which carry buns, by decreasing capacity
+  std::vector<int> types_by_capacity_;
+
+  executor::Executor* executor_{nullptr};
+
+  const algorithms::Landmarks* landmarks_{nullptr};
+  // towns with vehicles in any order, 'vehicle_town_indices_' are their
+  // indices in it, or -1
+  std::vector<int> vehicle_towns_;
+  std::vector<int> vehicle_town_indices_;
+
+  const algorithms::HubLabels* hub_labels_{nullptr};
+
+  // the graph, when it's a Tree, and numbers of vehicles by preorder index
+  const Tree* tree_{nullptr};
+  algorithms::FenwickTree tree_vehicles_;
+
+  // totals of big stocks don't fit into int
+  int64_t total_buns_amount_{0};
+  int64_t total_vehicles_{0};
 };
 
-
+using TrafficManager = BasicTrafficManager<AbstractGraph>;
@@ -0,0 +1,667 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <sstream>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
+#include "../src/Graphs/Algorithms/delta_stepping.h"
+#include "../src/Graphs/Algorithms/hub_labels.h"
+#include "../src/Graphs/Algorithms/landmarks.h"
+#include "../src/Graphs/Algorithms/min_cost_flow.h"
+#include "../src/Graphs/Algorithms/vehicle_routing.h"
+#include "../src/Graphs/Chain/chain.h"
+#include "../src/Graphs/Clique/clique.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// storage, that is not derived from AbstractGraph
+struct Cycle {
+  struct Edge {
+    int to;
+    int length;
+  };
+
+  int GetSize() const {
+    return size;
+  }
+
+  std::vector<Edge> GetEdges(int from) const {
+    return {{(from + 1) % size, 1}, {(from + size - 1) % size, 1}};
+  }
+
+  int size{0};
+};
+
+// path with edges of given length, 'Length' is the type of edge lengths
+template<typename Length>
+struct Path {
+  struct Edge {
+    int to;
+    Length length;
+  };
+
+  int GetSize() const {
+    return size;
+  }
+
+  std::vector<Edge> GetEdges(int from) const {
+    std::vector<Edge> edges;
+    if (from > 0) {
+      edges.push_back({from - 1, length});
+    }
+    if (from + 1 < size) {
+      edges.push_back({from + 1, length});
+    }
+    return edges;
+  }
+
+  int size{0};
+  Length length{0};
+};
+
+// int edges, which paths are measured in int64_t
+struct LongPath : Path<int> {
+  using Distance = int64_t;
+};
+
+int GetLength(const std::vector<AbstractGraph::Edge>& path) {
+  int length = 0;
+  for (const auto& edge : path) {
+    length += edge.length;
+  }
+  return length;
+}
+
+}  // namespace
+
+TEST(Algorithms, Concepts) {
+  static_assert(algorithms::GraphStorage<AbstractGraph>);
+  static_assert(algorithms::GraphStorage<Graph>);
+  static_assert(algorithms::GraphStorage<Chain>);
+  static_assert(algorithms::GraphStorage<Cycle>);
+  static_assert(algorithms::DenseGraphStorage<Clique>);
+  static_assert(!algorithms::DenseGraphStorage<Graph>);
+  static_assert(!algorithms::DenseGraphStorage<Cycle>);
+  static_assert(!algorithms::GraphStorage<int>);
+}
+
+TEST(Algorithms, BreadthFirstSearch) {
+  Cycle cycle{6};
+
+  const auto& tree = algorithms::BreadthFirstSearch(cycle, 0);
+  for (int to = 0; to < cycle.GetSize(); ++to) {
+    ASSERT_EQ(tree.GetDistance(to), std::min(to, 6 - to));
+    ASSERT_EQ(algorithms::RestorePath(tree, to).size(), std::min(to, 6 - to));
+  }
+
+  algorithms::BreadthFirstSearch(cycle, 0, 1);
+  ASSERT_EQ(tree.GetDistance(1), 1);
+  ASSERT_EQ(tree.GetDistance(3), algorithms::kInf);
+}
+
+TEST(Algorithms, Dijkstra) {
+  std::vector<std::vector<int>> matrix = {
+      {0, 1, 5, 9},
+      {1, 0, 1, 7},
+      {5, 1, 0, 1},
+      {9, 7, 1, 0}
+  };
+  Clique clique(matrix);
+  std::vector<std::vector<Graph::Edge>> connections(4);
+  for (int from = 0; from < 4; ++from) {
+    connections[from] = clique.GetEdges(from);
+  }
+  Graph graph(connections);
+
+  algorithms::SearchWorkspace dense;
+  algorithms::SearchWorkspace sparse;
+  algorithms::SearchWorkspace abstract;
+  for (int from = 0; from < 4; ++from) {
+    algorithms::Dijkstra(clique, from, &dense);
+    algorithms::Dijkstra(graph, from, &sparse);
+    algorithms::DijkstraForDense(
+        static_cast<const AbstractGraph&>(graph), from, &abstract);
+    for (int to = 0; to < 4; ++to) {
+      ASSERT_EQ(dense.GetDistance(to), sparse.GetDistance(to));
+      ASSERT_EQ(dense.GetDistance(to), abstract.GetDistance(to));
+      ASSERT_EQ(GetLength(algorithms::RestorePath(dense, to)),
+                std::abs(from - to));
+      ASSERT_EQ(algorithms::RestorePath(dense, to),
+                algorithms::RestorePath(sparse, to));
+    }
+  }
+}
+
+TEST(Algorithms, VisitClosestVertices) {
+  Chain chain(std::vector<int>{3, 1, 1, 4});
+
+  std::vector<std::pair<int, int>> visited;
+  algorithms::VisitClosestVertices(chain, 2, [&](int vertex, int distance) {
+    visited.emplace_back(vertex, distance);
+    return true;
+  });
+  std::vector<std::pair<int, int>> expected = {
+      {2, 0}, {1, 1}, {3, 1}, {0, 4}, {4, 5}};
+  ASSERT_EQ(visited, expected);
+
+  visited.clear();
+  algorithms::VisitClosestVertices(chain, 2, [&](int vertex, int distance) {
+    visited.emplace_back(vertex, distance);
+    return vertex != 1;
+  });
+  expected = {{2, 0}, {1, 1}};
+  ASSERT_EQ(visited, expected);
+}
+
+TEST(Algorithms, MultiSourceDijkstra) {
+  Chain chain(std::vector<int>{3, 1, 1, 4, 2});
+  std::vector<int> sources = {0, 4, 4};
+
+  std::vector<std::pair<int, int>> visited;
+  const auto& tree = algorithms::MultiSourceDijkstra(
+      chain, sources, [&](int vertex, int distance) {
+        visited.emplace_back(vertex, distance);
+        return true;
+      });
+  std::vector<std::pair<int, int>> expected = {
+      {0, 0}, {4, 0}, {5, 2}, {1, 3}, {2, 4}, {3, 4}};
+  ASSERT_EQ(visited, expected);
+
+  std::vector<int> closest_sources;
+  for (int vertex = 0; vertex < chain.GetSize(); ++vertex) {
+    int root = vertex;
+    while (tree.GetAncestor(root) != -1) {
+      root = tree.GetAncestor(root);
+    }
+    closest_sources.push_back(root);
+  }
+  ASSERT_EQ(closest_sources, std::vector<int>({0, 0, 0, 4, 4, 4}));
+
+  algorithms::SearchWorkspace single_source;
+  algorithms::DijkstraForSparse(chain, 2, &single_source);
+  algorithms::MultiSourceDijkstra(
+      chain, std::vector<int>{2}, [](int, int) { return true; });
+  for (int vertex = 0; vertex < chain.GetSize(); ++vertex) {
+    ASSERT_EQ(tree.GetDistance(vertex), single_source.GetDistance(vertex));
+  }
+}
+
+TEST(Algorithms, MinCostTransportation) {
+  {
+    // sending from 1 to the nearest demand 2 would make 3 send to 0
+    Chain chain(std::vector<int>{10, 1, 2});
+    auto shipments = algorithms::GetMinCostTransportation(
+        chain, std::vector<int>{-1, 1, -1, 1});
+    std::vector<algorithms::Shipment> expected = {{1, 0, 1}, {3, 2, 1}};
+    ASSERT_EQ(shipments, expected);
+  }
+  {
+    Chain chain(std::vector<int>{1, 1, 1});
+    auto shipments = algorithms::GetMinCostTransportation(
+        chain, std::vector<int>{0, 0, 0, 0});
+    ASSERT_TRUE(shipments.empty());
+  }
+  {
+    // 0 can't send its second unit to 4, which is isolated
+    Graph graph(std::vector<std::vector<Graph::Edge>>{
+        {{1, 1}}, {{0, 1}}, {{3, 1}}, {{2, 1}}, {}});
+    auto shipments = algorithms::GetMinCostTransportation(
+        graph, std::vector<int>{2, -1, 1, -1, -1});
+    std::vector<algorithms::Shipment> expected = {{0, 1, 1}, {2, 3, 1}};
+    ASSERT_EQ(shipments, expected);
+  }
+
+  // compares cost with the best assignment of single units
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 50; ++test) {
+    const int kSize = 7;
+    std::vector<std::vector<Graph::Edge>> connections(kSize);
+    std::uniform_int_distribution<int> length(1, 10);
+    for (int from = 1; from < kSize; ++from) {
+      int to = std::uniform_int_distribution<int>(0, from - 1)(gen);
+      int edge_length = length(gen);
+      connections[from].emplace_back(to, edge_length);
+      connections[to].emplace_back(from, edge_length);
+    }
+    for (int i = 0; i < 3; ++i) {
+      int from = std::uniform_int_distribution<int>(0, kSize - 1)(gen);
+      int to = std::uniform_int_distribution<int>(0, kSize - 1)(gen);
+      int edge_length = length(gen);
+      connections[from].emplace_back(to, edge_length);
+      connections[to].emplace_back(from, edge_length);
+    }
+    Graph graph(connections);
+
+    std::vector<int> supplies(kSize, 0);
+    std::vector<int> senders;
+    std::vector<int> receivers;
+    for (int unit = 0; unit < 5; ++unit) {
+      int from = std::uniform_int_distribution<int>(0, kSize - 1)(gen);
+      int to = std::uniform_int_distribution<int>(0, kSize - 1)(gen);
+      ++supplies[from];
+      --supplies[to];
+    }
+    for (int town = 0; town < kSize; ++town) {
+      for (int i = 0; i < supplies[town]; ++i) {
+        senders.push_back(town);
+      }
+      for (int i = 0; i < -supplies[town]; ++i) {
+        receivers.push_back(town);
+      }
+    }
+
+    std::vector<std::vector<int>> distances(kSize);
+    for (int from = 0; from < kSize; ++from) {
+      const auto& tree = algorithms::Dijkstra(graph, from);
+      for (int to = 0; to < kSize; ++to) {
+        distances[from].push_back(tree.GetDistance(to));
+      }
+    }
+    int best_cost = std::numeric_limits<int>::max();
+    do {
+      int cost = 0;
+      for (int i = 0; i < senders.size(); ++i) {
+        cost += distances[senders[i]][receivers[i]];
+      }
+      best_cost = std::min(best_cost, cost);
+    } while (std::next_permutation(receivers.begin(), receivers.end()));
+    if (senders.empty()) {
+      best_cost = 0;
+    }
+
+    int cost = 0;
+    std::vector<int> balance = supplies;
+    for (const auto& [from, to, amount] :
+        algorithms::GetMinCostTransportation(graph, supplies)) {
+      ASSERT_GT(amount, 0);
+      cost += distances[from][to] * amount;
+      balance[from] -= amount;
+      balance[to] += amount;
+    }
+    ASSERT_EQ(cost, best_cost);
+    ASSERT_EQ(balance, std::vector<int>(kSize, 0));
+  }
+}
+
+TEST(Algorithms, PlanTours) {
+  {
+    Chain chain(std::vector<int>{1, 1, 1, 1});
+    algorithms::DistanceMatrix distances(chain, {0, 3, 1, 4, 2});
+    ASSERT_EQ(distances.GetDistance(1, 3), 1);
+    ASSERT_EQ(distances.GetDistance(3, 0), 4);
+    ASSERT_EQ(distances.GetTown(2), 1);
+
+    auto tours = algorithms::PlanTours(distances, {0, 1, 1, 1, 1}, 4);
+    ASSERT_EQ(tours, std::vector<std::vector<int>>({{2, 4, 1, 3}}));
+    ASSERT_EQ(algorithms::GetTourLength(distances, tours[0]), 4);
+
+    tours = algorithms::PlanTours(distances, {0, 1, 1, 1, 1}, 2);
+    ASSERT_EQ(tours, std::vector<std::vector<int>>({{1, 3}, {2, 4}}));
+    ASSERT_TRUE(algorithms::PlanTours(distances, {0, 0, 0, 0, 0}, 2).empty());
+  }
+  {
+    // 0 - 1 and 2 - 3, stops unreachable from 0 get no tours
+    Graph graph({{{1, 5}}, {{0, 5}}, {{3, 7}}, {{2, 7}}});
+    algorithms::DistanceMatrix distances(graph, {0, 1, 2, 3});
+    ASSERT_EQ(distances.GetDistance(0, 1), 5);
+    ASSERT_EQ(distances.GetDistance(0, 2), algorithms::kInf);
+    ASSERT_EQ(distances.GetDistance(3, 1), algorithms::kInf);
+
+    auto tours = algorithms::PlanTours(distances, {0, 1, 1, 1}, 3);
+    ASSERT_EQ(tours, std::vector<std::vector<int>>({{1}}));
+    ASSERT_EQ(algorithms::GetTourLength(distances, tours[0]), 5);
+  }
+
+  // tours are valid and not longer than separate trips
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 20; ++test) {
+    const int kSize = 30;
+    std::vector<std::vector<Graph::Edge>> connections(kSize);
+    std::uniform_int_distribution<int> length(1, 10);
+    for (int from = 1; from < kSize; ++from) {
+      int to = std::uniform_int_distribution<int>(0, from - 1)(gen);
+      int edge_length = length(gen);
+      connections[from].emplace_back(to, edge_length);
+      connections[to].emplace_back(from, edge_length);
+    }
+    Graph graph(connections);
+    std::vector<int> towns(kSize);
+    std::iota(towns.begin(), towns.end(), 0);
+    std::shuffle(towns.begin(), towns.end(), gen);
+    algorithms::DistanceMatrix distances(graph, towns);
+
+    const int kCapacity = 5;
+    std::vector<int> loads(kSize, 0);
+    int separate_length = 0;
+    for (int stop = 1; stop < kSize; ++stop) {
+      loads[stop] = std::uniform_int_distribution<int>(0, kCapacity)(gen);
+      if (loads[stop] > 0) {
+        separate_length += distances.GetDistance(0, stop);
+      }
+    }
+
+    int64_t total_length = 0;
+    std::vector<int> delivered(kSize, 0);
+    for (const auto& tour : algorithms::PlanTours(distances, loads,
+                                                  kCapacity)) {
+      int tour_load = 0;
+      for (int stop : tour) {
+        ASSERT_EQ(delivered[stop], 0);
+        delivered[stop] = loads[stop];
+        tour_load += loads[stop];
+      }
+      ASSERT_LE(tour_load, kCapacity);
+      total_length += algorithms::GetTourLength(distances, tour);
+    }
+    ASSERT_EQ(delivered, loads);
+    ASSERT_LE(total_length, separate_length);
+  }
+}
+
+TEST(Algorithms, WideDistances) {
+  static_assert(std::is_same_v<algorithms::DistanceType<Graph>, int>);
+  static_assert(std::is_same_v<algorithms::DistanceType<Path<int64_t>>,
+                               int64_t>);
+  static_assert(std::is_same_v<algorithms::DistanceType<Path<int16_t>>, int>);
+  static_assert(std::is_same_v<algorithms::DistanceType<LongPath>, int64_t>);
+
+  const int kLength = 2'000'000'000;
+  {
+    Path<int64_t> path{4, kLength};
+    const auto& tree = algorithms::Dijkstra(path, 0);
+    ASSERT_EQ(tree.GetDistance(3), int64_t{3} * kLength);
+    ASSERT_EQ(tree.GetAncestor(3), 2);
+  }
+  {
+    LongPath path{{4, kLength}};
+    algorithms::WideSearchWorkspace workspace;
+    algorithms::DijkstraForSparse(path, 3, &workspace);
+    ASSERT_EQ(workspace.GetDistance(0), int64_t{3} * kLength);
+    algorithms::BreadthFirstSearch(path, 0, -1, &workspace);
+    ASSERT_EQ(workspace.GetDistance(3), int64_t{3} * kLength);
+  }
+  {
+    // paths longer than int maximum are unreachable instead of negative
+    Path<int> path{3, kLength};
+    const auto& tree = algorithms::Dijkstra(path, 0);
+    ASSERT_EQ(tree.GetDistance(1), kLength);
+    ASSERT_EQ(tree.GetDistance(2), algorithms::kInf);
+    ASSERT_EQ(algorithms::BreadthFirstSearch(path, 0).GetDistance(2),
+              algorithms::kInf);
+
+    Clique clique(std::vector<std::vector<int>>{
+        {0, kLength, algorithms::kInf},
+        {kLength, 0, kLength},
+        {algorithms::kInf, kLength, 0}});
+    ASSERT_EQ(algorithms::DijkstraForDense(clique, 0).GetDistance(2),
+              algorithms::kInf);
+  }
+  ASSERT_EQ(algorithms::SaturatingAdd(algorithms::kInf, 1), algorithms::kInf);
+  ASSERT_EQ(algorithms::SaturatingAdd<int64_t>(1, 2), 3);
+}
+
+TEST(Algorithms, DeltaStepping) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 20; ++test) {
+    const int kSize = 300;
+    std::vector<std::vector<Graph::Edge>> connections(kSize);
+    std::uniform_int_distribution<int> vertex(0, kSize - 1);
+    std::uniform_int_distribution<int> length(1, test % 2 ? 1000 : 5);
+    for (int i = 0; i < 3 * kSize; ++i) {
+      int from = vertex(gen);
+      int to = vertex(gen);
+      if (from != to) {
+        int edge_length = length(gen);
+        connections[from].emplace_back(to, edge_length);
+        connections[to].emplace_back(from, edge_length);
+      }
+    }
+    Graph graph(connections);
+
+    int from = vertex(gen);
+    algorithms::SearchWorkspace expected;
+    algorithms::Dijkstra(graph, from, &expected);
+    executor::ThreadPool thread_pool(3);
+    for (int threads_count : {1, 2, 4}) {
+      for (int delta : {1, 0, 100000}) {
+        algorithms::SearchWorkspace tree;
+        algorithms::DeltaStepping(graph, from,
+                                  {threads_count, delta, &thread_pool}, &tree);
+        for (int to = 0; to < kSize; ++to) {
+          ASSERT_EQ(tree.GetDistance(to), expected.GetDistance(to));
+          // shortest paths may differ only between paths of equal length
+          int ancestor = tree.GetAncestor(to);
+          if (to == from || !tree.IsReached(to)) {
+            ASSERT_EQ(ancestor, -1);
+            continue;
+          }
+          ASSERT_NE(ancestor, -1);
+          auto edges = graph.GetEdges(ancestor);
+          ASSERT_TRUE(std::any_of(
+              edges.begin(), edges.end(), [&](const Graph::Edge& edge) {
+                return edge.to == to && tree.GetDistance(ancestor) +
+                    edge.length == tree.GetDistance(to);
+              }));
+        }
+      }
+    }
+  }
+}
+
+TEST(Algorithms, DeltaSteppingLongEdge) {
+  // a sample of vertices misses the long edge, buckets must not grow with
+  // distances
+  const int kSize = 4096;
+  const int kLongLength = 1'000'000'000;
+  std::vector<std::vector<Graph::Edge>> connections(kSize);
+  for (int i = 0; i + 1 < kSize; ++i) {
+    connections[i].emplace_back(i + 1, 1);
+    connections[i + 1].emplace_back(i, 1);
+  }
+  connections[1].emplace_back(kSize - 1, kLongLength);
+  connections[kSize - 1].emplace_back(1, kLongLength);
+  Graph graph(connections);
+
+  algorithms::SearchWorkspace expected;
+  algorithms::Dijkstra(graph, 1, &expected);
+  executor::ThreadPool thread_pool(3);
+  for (int delta : {1, 0}) {
+    algorithms::SearchWorkspace tree;
+    algorithms::DeltaStepping(graph, 1, {2, delta, &thread_pool}, &tree);
+    for (int to = 0; to < kSize; ++to) {
+      ASSERT_EQ(tree.GetDistance(to), expected.GetDistance(to));
+    }
+  }
+}
+
+TEST(Algorithms, Landmarks) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    // two components, so some bounds are infinite
+    const int kSize = 60;
+    std::vector<std::vector<Graph::Edge>> connections(kSize);
+    std::uniform_int_distribution<int> vertex(0, kSize / 2 - 1);
+    std::uniform_int_distribution<int> length(1, 100);
+    for (int i = 0; i < 2 * kSize; ++i) {
+      int shift = i % 2 * kSize / 2;
+      int from = vertex(gen) + shift;
+      int to = vertex(gen) + shift;
+      int edge_length = length(gen);
+      connections[from].emplace_back(to, edge_length);
+      connections[to].emplace_back(from, edge_length);
+    }
+    Graph graph(connections);
+    auto selection = test % 2 ? algorithms::LandmarkSelection::kFarthest
+                              : algorithms::LandmarkSelection::kAvoid;
+    executor::ThreadPool thread_pool(2);
+    auto landmarks =
+        algorithms::Landmarks::Build(graph, 4, selection, &thread_pool);
+    ASSERT_EQ(landmarks.GetSize(), kSize);
+    ASSERT_EQ(landmarks.GetCount(), 4);
+
+    std::vector<int> goals = {vertex(gen), vertex(gen), vertex(gen)};
+    std::sort(goals.begin(), goals.end());
+    goals.erase(std::unique(goals.begin(), goals.end()), goals.end());
+    algorithms::LandmarksPotential potential(landmarks, goals);
+    for (int from = 0; from < kSize; ++from) {
+      algorithms::SearchWorkspace tree;
+      algorithms::Dijkstra(graph, from, &tree);
+      int closest_goal_dist = algorithms::kInf;
+      for (int to = 0; to < kSize; ++to) {
+        int bound = landmarks.GetLowerBound(from, to);
+        if (tree.IsReached(to)) {
+          ASSERT_LE(bound, tree.GetDistance(to));
+        } else {
+          ASSERT_EQ(bound, algorithms::kInf);
+        }
+      }
+      for (int goal : goals) {
+        closest_goal_dist =
+            std::min(closest_goal_dist, tree.GetDistance(goal));
+      }
+      ASSERT_LE(potential(from), closest_goal_dist);
+
+      // goals are visited in order of distance, with exact distances
+      std::vector<int> visited_distances;
+      algorithms::GoalDirectedSearch(
+          graph, from, potential, [&](int vertex, int distance) {
+            if (std::find(goals.begin(), goals.end(), vertex) !=
+                goals.end()) {
+              visited_distances.push_back(distance);
+            }
+            return true;
+          });
+      std::vector<int> expected_distances;
+      for (int goal : goals) {
+        if (tree.IsReached(goal)) {
+          expected_distances.push_back(tree.GetDistance(goal));
+        }
+      }
+      std::sort(expected_distances.begin(), expected_distances.end());
+      ASSERT_EQ(visited_distances, expected_distances);
+    }
+
+    std::stringstream stream;
+    landmarks.Write(stream);
+    ASSERT_EQ(algorithms::Landmarks::Read(stream), landmarks);
+  }
+
+  std::stringstream malformed("Landmarks 2 1\n5\n0\n1\n");
+  ASSERT_EQ(algorithms::Landmarks::Read(malformed), std::nullopt);
+}
+
+TEST(Algorithms, HubLabels) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 5; ++test) {
+    // two components, grids with random lengths and shortcuts, so labels
+    // are long enough for whole blocks to be compared
+    const int kSide = 12;
+    const int kSize = 2 * kSide * kSide;
+    std::vector<std::vector<Graph::Edge>> connections(kSize);
+    std::uniform_int_distribution<int> length(1, test % 2 ? 3 : 100);
+    auto add_edge = [&](int from, int to) {
+      int edge_length = length(gen);
+      connections[from].emplace_back(to, edge_length);
+      connections[to].emplace_back(from, edge_length);
+    };
+    for (int vertex = 0; vertex < kSize; ++vertex) {
+      int row = vertex % (kSide * kSide) / kSide;
+      int column = vertex % kSide;
+      if (column + 1 < kSide) {
+        add_edge(vertex, vertex + 1);
+      }
+      if (row + 1 < kSide) {
+        add_edge(vertex, vertex + kSide);
+      }
+    }
+    std::uniform_int_distribution<int> vertex(0, kSide * kSide - 1);
+    for (int i = 0; i < 10; ++i) {
+      add_edge(vertex(gen), vertex(gen));
+    }
+    Graph graph(connections);
+    auto hub_labels = algorithms::HubLabels::Build(graph);
+    ASSERT_EQ(hub_labels.GetSize(), kSize);
+    ASSERT_LT(hub_labels.GetLabelsSize(), int64_t{kSize} * kSize / 4);
+    // roots of a batch don't prune each other
+    executor::ThreadPool thread_pool(3);
+    auto pool_hub_labels = algorithms::HubLabels::Build(graph, &thread_pool);
+    ASSERT_LT(pool_hub_labels.GetLabelsSize(), int64_t{kSize} * kSize / 4);
+
+    for (int from = 0; from < kSize; ++from) {
+      const algorithms::SearchWorkspace& tree =
+          algorithms::Dijkstra(graph, from);
+      for (int to = 0; to < kSize; ++to) {
+        ASSERT_EQ(hub_labels.GetDistance(from, to), tree.GetDistance(to));
+        ASSERT_EQ(pool_hub_labels.GetDistance(from, to),
+                  tree.GetDistance(to));
+      }
+    }
+  }
+
+  ASSERT_EQ(algorithms::HubLabels::Build(Graph(0)).GetSize(), 0);
+}
+
+TEST(Algorithms, SearchWorkspace) {
+  algorithms::SearchWorkspace workspace;
+
+  workspace.Reset(3);
+  ASSERT_EQ(workspace.GetSize(), 3);
+  for (int vertex = 0; vertex < 3; ++vertex) {
+    ASSERT_FALSE(workspace.IsReached(vertex));
+    ASSERT_EQ(workspace.GetDistance(vertex), algorithms::kInf);
+    ASSERT_EQ(workspace.GetAncestor(vertex), -1);
+  }
+
+  workspace.Update(1, 5, 0);
+  ASSERT_TRUE(workspace.IsReached(1));
+  ASSERT_FALSE(workspace.IsReached(2));
+  ASSERT_EQ(workspace.GetDistance(1), 5);
+  ASSERT_EQ(workspace.GetAncestor(1), 0);
+
+  workspace.Reset(5);
+  for (int vertex = 0; vertex < 5; ++vertex) {
+    ASSERT_FALSE(workspace.IsReached(vertex));
+  }
+
+  Cycle cycle{5};
+  for (int from = 0; from < 5; ++from) {
+    algorithms::DijkstraForSparse(cycle, from, &workspace);
+    for (int to = 0; to < 5; ++to) {
+      int expected = std::min((to - from + 5) % 5, (from - to + 5) % 5);
+      ASSERT_EQ(workspace.GetDistance(to), expected);
+    }
+  }
+}
+
+TEST(Algorithms, VertexBitset) {
+  algorithms::VertexBitset bitset;
+
+  bitset.Assign(130, true);
+  ASSERT_EQ(bitset.GetSize(), 130);
+  ASSERT_EQ(bitset.FindFirst(), 0);
+  int count = 0;
+  bitset.ForEachSetBit([&count](int index) {
+    ASSERT_EQ(index, count);
+    ++count;
+  });
+  ASSERT_EQ(count, 130);
+
+  for (int index = 0; index < 129; ++index) {
+    bitset.Reset(index);
+  }
+  ASSERT_FALSE(bitset.Test(0));
+  ASSERT_TRUE(bitset.Test(129));
+  ASSERT_EQ(bitset.FindFirst(), 129);
+
+  bitset.Assign(70, false);
+  ASSERT_EQ(bitset.FindFirst(), -1);
+  bitset.Set(3);
+  bitset.Set(64);
+  std::vector<int> indices;
+  bitset.ForEachSetBit([&indices](int index) {
+    indices.push_back(index);
+  });
+  ASSERT_EQ(indices, std::vector<int>({3, 64}));
+}
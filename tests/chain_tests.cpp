@@ -179,6 +179,17 @@ TEST(Chain, GetAnyPath) {
   }
 }
 
+TEST(Chain, GetDistance) {
+  Chain graph = GenerateTestChain();
+  for (int from = 0; from < graph.GetSize(); ++from) {
+    for (int to = 0; to < graph.GetSize(); ++to) {
+      ASSERT_EQ(graph.GetDistance(from, to),
+                GetPathLength(graph, graph.GetShortestPath(from, to), from));
+    }
+  }
+  ASSERT_EQ(Chain(std::vector<int>{}).GetDistance(0, 0), 0);
+}
+
 TEST(Chain, GetShortestPath) {
   {
     Chain graph(6);
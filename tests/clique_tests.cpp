@@ -1,3 +1,6 @@
+#include <random>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
 #include "../src/Graphs/Clique/clique.h"
 #include "gtest/gtest.h"
 
@@ -242,6 +245,35 @@ TEST(Clique, GetShortestPaths) {
   }
 }
 
+TEST(Clique, MetricClosure) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    const int kSize = 30;
+    // every other test is metric: lengths between 50 and 100
+    std::uniform_int_distribution<int> length(test % 2 ? 50 : 1, 100);
+    std::vector<std::vector<int>> matrix(kSize, std::vector<int>(kSize, 0));
+    for (int from = 0; from < kSize; ++from) {
+      for (int to = 0; to < from; ++to) {
+        matrix[from][to] = matrix[to][from] = length(gen);
+      }
+    }
+    Clique graph(matrix);
+
+    for (int from = 0; from < kSize; ++from) {
+      const auto& tree = algorithms::Dijkstra(graph, from);
+      for (int to = 0; to < kSize; ++to) {
+        ASSERT_EQ(graph.GetDistance(from, to), tree.GetDistance(to));
+        auto path = graph.GetShortestPath(from, to);
+        ASSERT_EQ(GetPathLength(graph, path, from), tree.GetDistance(to));
+        ASSERT_EQ(path.empty() ? from : path.back().to, to);
+        if (test % 2 == 1 && from != to) {
+          ASSERT_EQ(path.size(), 1);
+        }
+      }
+    }
+  }
+}
+
 TEST(Clique, GetEdgesCount) {
   {
     Clique graph;
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
+#include "../src/Graphs/Composite/composite.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// Cities with random lengths, corridors with random lengths and new inner
+// vertices between random towns of cities, and a Graph of random roads over
+// some towns. The last vertex is isolated.
+Composite GenerateNetwork(std::mt19937* gen) {
+  std::uniform_int_distribution<int> length(1, 100);
+  std::vector<Composite::Part> parts;
+  std::vector<int> towns;
+  int n = 0;
+  const int kCitiesCount = 5;
+  for (int city = 0; city < kCitiesCount; ++city) {
+    int size = std::uniform_int_distribution<int>(1, 6)(*gen);
+    std::vector<std::vector<int>> matrix(size, std::vector<int>(size, 0));
+    for (int from = 0; from < size; ++from) {
+      for (int to = 0; to < from; ++to) {
+        matrix[from][to] = matrix[to][from] = length(*gen);
+      }
+    }
+    Composite::Part part{{}, Clique(matrix)};
+    for (int i = 0; i < size; ++i) {
+      part.vertices.push_back(n);
+      towns.push_back(n++);
+    }
+    parts.push_back(std::move(part));
+  }
+
+  std::uniform_int_distribution<int> town(0, towns.size() - 1);
+  for (int corridor = 0; corridor < 6; ++corridor) {
+    int inner_count = std::uniform_int_distribution<int>(0, 3)(*gen);
+    Composite::Part part;
+    part.vertices.push_back(towns[town(*gen)]);
+    for (int i = 0; i < inner_count; ++i) {
+      part.vertices.push_back(n++);
+    }
+    int end = towns[town(*gen)];
+    if (end == part.vertices[0]) {
+      continue;
+    }
+    part.vertices.push_back(end);
+    std::vector<int> lengths(part.vertices.size() - 1);
+    for (int& edge_length : lengths) {
+      edge_length = length(*gen);
+    }
+    part.graph = Chain(lengths);
+    parts.push_back(std::move(part));
+  }
+
+  Composite::Part roads;
+  for (int i = 0; i < towns.size(); i += 2) {
+    roads.vertices.push_back(towns[i]);
+  }
+  int roads_size = roads.vertices.size();
+  std::vector<std::vector<Graph::Edge>> list(roads_size);
+  for (int i = 0; i < roads_size; ++i) {
+    int to = std::uniform_int_distribution<int>(0, roads_size - 1)(*gen);
+    if (to != i) {
+      int edge_length = length(*gen);
+      list[i].emplace_back(to, edge_length);
+      list[to].emplace_back(i, edge_length);
+    }
+  }
+  roads.graph = Graph(list);
+  parts.push_back(std::move(roads));
+  return Composite(n + 1, std::move(parts));
+}
+
+}  // namespace
+
+TEST(Composite, Constructors) {
+  {
+    Composite graph;
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Composite graph(0);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    // cities {0, 1, 2, 3} and {6, 7, 8, 9}, corridor 3 - 4 - 5 - 6
+    Composite graph(10);
+
+    ASSERT_EQ(graph.GetSize(), 10);
+    ASSERT_EQ(graph.GetEdgesCount(), 6 + 3 + 6);
+    ASSERT_EQ(graph.GetBoundarySize(), 2);
+    ASSERT_EQ(graph.GetEdges(3).size(), 4);
+    ASSERT_EQ(graph.GetEdges(4).size(), 2);
+    ASSERT_EQ(graph.GetEdgeLength(5, 6), 1);
+    ASSERT_EQ(graph.GetDistance(0, 9), 5);
+    ASSERT_EQ(graph.GetShortestPath(0, 9).size(), 5);
+  }
+  {
+    std::vector<Composite::Part> parts;
+    parts.push_back({{2, 0}, Chain(std::vector<int>{7})});
+
+    Composite graph(3, std::move(parts));
+    ASSERT_EQ(graph.GetEdgesCount(), 1);
+    ASSERT_EQ(graph.GetBoundarySize(), 0);
+    ASSERT_EQ(graph.GetEdgeLength(0, 2), 7);
+    ASSERT_EQ(graph.GetDistance(2, 0), 7);
+    ASSERT_EQ(graph.GetDistance(0, 1), algorithms::kInf);
+    ASSERT_TRUE(graph.GetShortestPath(0, 1).empty());
+  }
+  {
+    // overlay of about 20'000 boundary vertices is searched on demand
+    Composite graph(60'000);
+
+    ASSERT_EQ(graph.GetBoundarySize(), 19'999);
+    ASSERT_EQ(graph.GetDistance(0, 59'999), 39'999);
+    ASSERT_EQ(graph.GetShortestPath(59'999, 0).size(), 39'999);
+  }
+}
+
+TEST(Composite, GetShortestPath) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    Composite graph = GenerateNetwork(&gen);
+    std::vector<std::vector<Graph::Edge>> list(graph.GetSize());
+    for (int from = 0; from < graph.GetSize(); ++from) {
+      list[from] = graph.GetEdges(from);
+    }
+    Graph expected(list);
+
+    for (int from = 0; from < graph.GetSize(); ++from) {
+      // searches of the graph and its parts don't invalidate the tree
+      const auto& tree = algorithms::Dijkstra(expected, from);
+      auto paths = graph.GetShortestPaths(from);
+      for (int to = 0; to < graph.GetSize(); ++to) {
+        ASSERT_EQ(graph.GetDistance(from, to), tree.GetDistance(to));
+        auto path = graph.GetShortestPath(from, to);
+        ASSERT_EQ(path, paths[to]);
+        ASSERT_EQ(path.empty(),
+                  from == to || tree.GetDistance(to) == algorithms::kInf);
+        int vertex = from;
+        int length = 0;
+        for (const auto& edge : path) {
+          // parts may have parallel edges
+          auto edges = graph.GetEdges(vertex);
+          ASSERT_NE(std::find(edges.begin(), edges.end(), edge),
+                    edges.end());
+          length += edge.length;
+          vertex = edge.to;
+        }
+        if (!path.empty()) {
+          ASSERT_EQ(vertex, to);
+          ASSERT_EQ(length, tree.GetDistance(to));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,211 @@
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "../src/Executor/async.h"
+#include "../src/Executor/executor.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// executor of an application, which runs tasks only when asked to
+class ManualExecutor : public executor::Executor {
+ public:
+  void Submit(Task task) override {
+    std::lock_guard lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  int GetConcurrency() const override {
+    return 3;
+  }
+
+  int RunAll() {
+    std::vector<Task> tasks;
+    {
+      std::lock_guard lock(mutex_);
+      std::swap(tasks, tasks_);
+    }
+    for (auto& task : tasks) {
+      task();
+    }
+    return tasks.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<Task> tasks_;
+};
+
+}  // namespace
+
+TEST(Executor, ThreadPool) {
+  std::atomic<int> sum = 0;
+  {
+    executor::ThreadPool thread_pool(3);
+    ASSERT_EQ(thread_pool.GetConcurrency(), 3);
+    for (int i = 1; i <= 100; ++i) {
+      thread_pool.Submit([&sum, i] {
+        sum += i;
+      });
+    }
+  }
+  // destructor runs remaining tasks
+  ASSERT_EQ(sum, 5050);
+}
+
+TEST(Executor, TaskGroup) {
+  executor::ThreadPool thread_pool(2);
+  std::atomic<int> count = 0;
+  {
+    // tasks wait for their own groups, which needs more threads than the
+    // pool has, unless waiting threads help
+    executor::TaskGroup group(&thread_pool);
+    for (int i = 0; i < 8; ++i) {
+      group.Run([&thread_pool, &count] {
+        executor::TaskGroup nested(&thread_pool);
+        for (int j = 0; j < 8; ++j) {
+          nested.Run([&count] {
+            ++count;
+          });
+        }
+        nested.Wait();
+      });
+    }
+    group.Wait();
+    ASSERT_EQ(count, 64);
+    group.Run([&count] {
+      ++count;
+    });
+  }
+  ASSERT_EQ(count, 65);
+}
+
+TEST(Executor, ParallelFor) {
+  executor::ThreadPool thread_pool(3);
+  int slots_count = executor::GetSlotsCount(thread_pool);
+  ASSERT_EQ(slots_count, 4);
+  for (size_t grain : {1, 7, 1000, 5000}) {
+    std::vector<int> visits(3000, 0);
+    std::vector<std::atomic<int>> busy_slots(slots_count);
+    std::atomic<bool> is_exclusive = true;
+    executor::ParallelFor(
+        thread_pool, 100, 3000, grain,
+        [&](int slot, size_t begin, size_t end) {
+          ASSERT_TRUE(0 <= slot && slot < slots_count);
+          ASSERT_LE(end - begin, grain);
+          if (busy_slots[slot].exchange(1) != 0) {
+            is_exclusive = false;
+          }
+          for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+          }
+          busy_slots[slot] = 0;
+        });
+    ASSERT_TRUE(is_exclusive);
+    for (int i = 0; i < 3000; ++i) {
+      ASSERT_EQ(visits[i], i < 100 ? 0 : 1);
+    }
+  }
+
+  // with one slot everything runs on the calling thread
+  std::vector<int> slots;
+  executor::ParallelFor(
+      thread_pool, 0, 10, 3,
+      [&](int slot, size_t, size_t) {
+        slots.push_back(slot);
+      },
+      1);
+  ASSERT_EQ(slots, std::vector<int>(4, 0));
+}
+
+TEST(Executor, InjectedExecutor) {
+  ManualExecutor manual;
+  // tasks are not run, the calling thread processes all chunks
+  std::vector<int> values(1000);
+  executor::ParallelFor(manual, 0, values.size(), 10,
+                        [&](int, size_t begin, size_t end) {
+                          std::iota(values.begin() + begin,
+                                    values.begin() + end,
+                                    static_cast<int>(begin));
+                        });
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(values[i], i);
+  }
+  // late tasks find no chunks left
+  ASSERT_EQ(manual.RunAll(), 3);
+
+  executor::SetDefaultExecutor(&manual);
+  ASSERT_EQ(&executor::GetDefaultExecutor(), &manual);
+  int count = 0;
+  {
+    executor::TaskGroup group;
+    group.Run([&count] {
+      ++count;
+    });
+    ASSERT_EQ(manual.RunAll(), 1);
+  }
+  ASSERT_EQ(count, 1);
+  executor::SetDefaultExecutor(nullptr);
+  ASSERT_NE(&executor::GetDefaultExecutor(), &manual);
+}
+
+TEST(Executor, Strand) {
+  executor::ThreadPool thread_pool(3);
+  std::vector<int> order;
+  executor::Strand strand(&thread_pool);
+  ASSERT_EQ(strand.GetConcurrency(), 1);
+  // tasks of the strand don't run at the same time, so 'order' needs no lock
+  for (int i = 0; i < 100; ++i) {
+    strand.Submit([&order, i] {
+      order.push_back(i);
+    });
+  }
+  std::atomic<bool> is_finished = false;
+  strand.Submit([&is_finished] {
+    is_finished = true;
+  });
+  while (!is_finished) {
+    std::this_thread::yield();
+  }
+
+  std::vector<int> expected(100);
+  std::iota(expected.begin(), expected.end(), 0);
+  ASSERT_EQ(order, expected);
+}
+
+namespace {
+
+executor::Async<int> Square(executor::Executor* executor, int value) {
+  co_await executor::Schedule(*executor);
+  co_return value * value;
+}
+
+executor::Async<int> SumSquares(executor::Executor* executor, int count) {
+  int sum = 0;
+  for (int i = 1; i <= count; ++i) {
+    sum += co_await Square(executor, i);
+  }
+  co_return sum;
+}
+
+}  // namespace
+
+TEST(Executor, Async) {
+  executor::ThreadPool thread_pool(2);
+  ASSERT_EQ(executor::SyncWait(SumSquares(&thread_pool, 10)), 385);
+
+  // nothing runs until the event loop runs it
+  ManualExecutor event_loop;
+  std::optional<int> result;
+  executor::Start<int>(SumSquares(&event_loop, 3), [&result](int value) {
+    result = value;
+  });
+  while (!result) {
+    ASSERT_EQ(event_loop.RunAll(), 1);
+  }
+  ASSERT_EQ(result, 14);
+}
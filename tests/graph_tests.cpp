@@ -343,3 +343,127 @@ TEST(Graph, GetEdgesCount) {
     ASSERT_EQ(graph.GetEdgesCount(), 5);
   }
 }
+
+TEST(Graph, VertexOrder) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(4, 6)},
+      {Graph::Edge(2, 3), Graph::Edge(4, 1)},
+      {Graph::Edge(1, 3), Graph::Edge(3, 2)},
+      {Graph::Edge(2, 2), Graph::Edge(4, 7)},
+      {Graph::Edge(0, 6), Graph::Edge(1, 1), Graph::Edge(3, 7)},
+      {Graph::Edge(6, 4)},
+      {Graph::Edge(5, 4)}};
+
+  Graph expected(connections);
+
+  for (auto order : {Graph::VertexOrder::kBreadthFirst,
+                     Graph::VertexOrder::kReverseCuthillMcKee}) {
+    Graph graph(connections, order);
+
+    ASSERT_EQ(graph.GetSize(), 7);
+    ASSERT_EQ(graph.GetEdgesCount(), 6);
+    for (int i = 0; i < graph.GetSize(); ++i) {
+      ASSERT_EQ(graph.GetEdges(i), connections[i]);
+    }
+
+    for (int i = 0; i < graph.GetSize(); ++i) {
+      auto paths = graph.GetShortestPaths(i);
+      auto expected_paths = expected.GetShortestPaths(i);
+      for (int j = 0; j < graph.GetSize(); ++j) {
+        ASSERT_EQ(GetPathLength(graph, paths[j], i),
+                  GetPathLength(expected, expected_paths[j], i));
+        ASSERT_EQ(GetPathLength(graph, graph.GetShortestPath(i, j), i),
+                  GetPathLength(expected, expected_paths[j], i));
+        ASSERT_EQ(graph.GetAnyPath(i, j).empty(),
+                  expected.GetAnyPath(i, j).empty());
+        if (!graph.GetAnyPath(i, j).empty()) {
+          ASSERT_NE(GetPathLength(graph, graph.GetAnyPath(i, j), i),
+                    std::nullopt);
+          ASSERT_EQ(graph.GetAnyPath(i, j).back().to, j);
+        }
+      }
+    }
+  }
+}
+
+TEST(Graph, ShortestPathAlgorithm) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(4, 6)},
+      {Graph::Edge(2, 3), Graph::Edge(4, 1)},
+      {Graph::Edge(1, 3), Graph::Edge(3, 2)},
+      {Graph::Edge(2, 2), Graph::Edge(4, 7)},
+      {Graph::Edge(0, 6), Graph::Edge(1, 1), Graph::Edge(3, 7)},
+      {Graph::Edge(6, 4)},
+      {Graph::Edge(5, 4)}};
+
+  Graph expected(connections);
+  Graph graph(connections);
+  for (int threads_count : {1, 3}) {
+    graph.SetShortestPathAlgorithm(
+        Graph::ShortestPathAlgorithm::kDeltaStepping, threads_count);
+    for (int i = 0; i < graph.GetSize(); ++i) {
+      auto paths = graph.GetShortestPaths(i);
+      auto expected_paths = expected.GetShortestPaths(i);
+      for (int j = 0; j < graph.GetSize(); ++j) {
+        ASSERT_EQ(paths[j], expected_paths[j]);
+        ASSERT_EQ(graph.GetShortestPath(i, j), expected_paths[j]);
+      }
+    }
+  }
+}
+
+TEST(Graph, Landmarks) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(4, 6)},
+      {Graph::Edge(2, 3), Graph::Edge(4, 1)},
+      {Graph::Edge(1, 3), Graph::Edge(3, 2)},
+      {Graph::Edge(2, 2), Graph::Edge(4, 7)},
+      {Graph::Edge(0, 6), Graph::Edge(1, 1), Graph::Edge(3, 7)},
+      {Graph::Edge(6, 4)},
+      {Graph::Edge(5, 4)}};
+
+  Graph expected(connections);
+  Graph graph(connections, Graph::VertexOrder::kReverseCuthillMcKee);
+  graph.BuildLandmarks(2);
+  ASSERT_EQ(graph.GetLandmarks().GetCount(), 2);
+  Graph copy(connections, Graph::VertexOrder::kReverseCuthillMcKee);
+  copy.SetLandmarks(graph.GetLandmarks());
+  for (int i = 0; i < graph.GetSize(); ++i) {
+    for (int j = 0; j < graph.GetSize(); ++j) {
+      ASSERT_EQ(graph.GetShortestPath(i, j), expected.GetShortestPath(i, j));
+      ASSERT_EQ(copy.GetShortestPath(i, j), expected.GetShortestPath(i, j));
+    }
+  }
+}
+
+TEST(Graph, DistanceWidth) {
+  const int kLength = 2'000'000'000;
+  // 0 - 1 - 2 - 3, the path from 0 to 3 is longer than int, 4 is isolated
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(1, kLength)},
+      {Graph::Edge(0, kLength), Graph::Edge(2, kLength)},
+      {Graph::Edge(1, kLength), Graph::Edge(3, kLength)},
+      {Graph::Edge(2, kLength)},
+      {}};
+
+  Graph graph(connections, Graph::VertexOrder::kReverseCuthillMcKee);
+  ASSERT_EQ(graph.GetDistance(0, 1), kLength);
+  ASSERT_EQ(graph.GetDistance(1, 1), 0);
+  ASSERT_EQ(graph.GetDistance(0, 3), algorithms::kInfDistance<int64_t>);
+  ASSERT_EQ(graph.GetDistance(0, 4), algorithms::kInfDistance<int64_t>);
+
+  graph.SetDistanceWidth(Graph::DistanceWidth::k64Bit);
+  ASSERT_EQ(graph.GetDistance(0, 1), kLength);
+  ASSERT_EQ(graph.GetDistance(0, 3), int64_t{3} * kLength);
+  ASSERT_EQ(graph.GetDistance(3, 0), int64_t{3} * kLength);
+  ASSERT_EQ(graph.GetDistance(0, 4), algorithms::kInfDistance<int64_t>);
+  ASSERT_EQ(graph.GetShortestPath(0, 3),
+            std::vector<Graph::Edge>({Graph::Edge(1, kLength),
+                                      Graph::Edge(2, kLength),
+                                      Graph::Edge(3, kLength)}));
+  ASSERT_TRUE(graph.GetShortestPath(0, 4).empty());
+  auto paths = graph.GetShortestPaths(3);
+  ASSERT_EQ(paths[0].size(), 3);
+  ASSERT_EQ(paths[0].back(), Graph::Edge(0, kLength));
+  ASSERT_TRUE(paths[4].empty());
+}
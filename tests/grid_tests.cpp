@@ -0,0 +1,140 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Graphs/Grid/grid.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+std::vector<std::vector<Grid::Edge>> GetList(const Grid& grid) {
+  std::vector<std::vector<Grid::Edge>> list(grid.GetSize());
+  for (int from = 0; from < grid.GetSize(); ++from) {
+    list[from] = grid.GetEdges(from);
+  }
+  return list;
+}
+
+int GetLength(const std::vector<Grid::Edge>& path) {
+  int length = 0;
+  for (const auto& edge : path) {
+    length += edge.length;
+  }
+  return length;
+}
+
+// checks, that every path is the shortest one and its edges exist
+void CheckShortestPaths(const Grid& grid) {
+  Graph expected(GetList(grid));
+  for (int from = 0; from < grid.GetSize(); ++from) {
+    // searches of the grid don't invalidate the tree
+    const auto& tree = algorithms::Dijkstra(expected, from);
+    auto paths = grid.GetShortestPaths(from);
+    for (int to = 0; to < grid.GetSize(); ++to) {
+      ASSERT_EQ(grid.GetDistance(from, to), tree.GetDistance(to));
+      auto path = grid.GetShortestPath(from, to);
+      ASSERT_EQ(GetLength(path), tree.GetDistance(to));
+      ASSERT_EQ(path, paths[to]);
+      int vertex = from;
+      for (const auto& edge : path) {
+        ASSERT_EQ(grid.GetEdgeLength(vertex, edge.to), edge.length);
+        vertex = edge.to;
+      }
+      ASSERT_EQ(vertex, to);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Grid, Constructors) {
+  {
+    Grid graph;
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Grid graph(0);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Grid graph(12);
+
+    ASSERT_EQ(graph.GetRows(), 4);
+    ASSERT_EQ(graph.GetColumns(), 3);
+    ASSERT_EQ(graph.GetEdgesCount(), 17);
+    ASSERT_EQ(graph.GetEdges(0).size(), 2);
+    ASSERT_EQ(graph.GetEdges(1).size(), 3);
+    ASSERT_EQ(graph.GetEdges(4).size(), 4);
+    ASSERT_EQ(graph.GetEdgeLength(4, 7), 1);
+  }
+  {
+    Grid graph(1, 5, 3);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 4);
+    ASSERT_EQ(graph.GetEdgeLength(2, 3), 3);
+    ASSERT_EQ(graph.GetDistance(0, 4), 12);
+  }
+  {
+    Grid graph({1, 2}, {3, 4, 5});
+
+    ASSERT_EQ(graph.GetSize(), 6);
+    ASSERT_EQ(graph.GetEdgesCount(), 7);
+    ASSERT_EQ(graph.GetEdgeLength(0, 1), 1);
+    ASSERT_EQ(graph.GetEdgeLength(4, 5), 2);
+    ASSERT_EQ(graph.GetEdgeLength(2, 5), 5);
+  }
+}
+
+TEST(Grid, GetEdges) {
+  // larger than a tile, so edges cross tiles
+  Grid graph(20, 37);
+  for (int from = 0; from < graph.GetSize(); ++from) {
+    int row = from / 37;
+    int column = from % 37;
+    std::vector<Grid::Edge> expected;
+    if (row > 0) {
+      expected.emplace_back(from - 37, 1);
+    }
+    if (column > 0) {
+      expected.emplace_back(from - 1, 1);
+    }
+    if (column + 1 < 37) {
+      expected.emplace_back(from + 1, 1);
+    }
+    if (row + 1 < 20) {
+      expected.emplace_back(from + 37, 1);
+    }
+    ASSERT_EQ(graph.GetEdges(from), expected);
+  }
+}
+
+TEST(Grid, Uniform) {
+  CheckShortestPaths(Grid(7, 9, 5));
+  Grid graph(7, 9, 5);
+  ASSERT_EQ(graph.GetDistance(0, 62), 5 * (6 + 8));
+  ASSERT_EQ(graph.GetAnyPath(0, 62), graph.GetShortestPath(0, 62));
+}
+
+TEST(Grid, NonUniform) {
+  std::mt19937 gen(20220314);
+  std::uniform_int_distribution<int> length(1, 100);
+  // every pair is a search on a non-uniform grid, so grids are small
+  for (auto [rows, columns] : {std::pair{1, 30}, std::pair{6, 7},
+                               std::pair{9, 5}}) {
+    std::vector<int> row_lengths(rows);
+    std::vector<int> column_lengths(columns);
+    for (int& row_length : row_lengths) {
+      row_length = length(gen);
+    }
+    for (int& column_length : column_lengths) {
+      column_length = length(gen);
+    }
+    CheckShortestPaths(Grid(row_lengths, column_lengths));
+  }
+}
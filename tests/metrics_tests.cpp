@@ -0,0 +1,93 @@
+#include <thread>
+
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Metrics/metrics.h"
+#include "../src/TrafficManager/traffic_manager.h"
+#include "gtest/gtest.h"
+
+using metrics::Counter;
+using metrics::Histogram;
+
+TEST(Metrics, CollectAndReset) {
+  metrics::Reset();
+  metrics::Add(Counter::kDijkstraRuns, 2);
+  metrics::Add(Counter::kDijkstraRuns, 3);
+  metrics::Record(Histogram::kPathEdges, 0);
+  metrics::Record(Histogram::kPathEdges, 5);
+  metrics::Record(Histogram::kPathEdges, 7);
+
+  auto snapshot = metrics::Collect();
+  ASSERT_EQ(snapshot.GetCounter(Counter::kDijkstraRuns), 5);
+  ASSERT_EQ(snapshot.GetCounter(Counter::kHeapPushes), 0);
+  ASSERT_EQ(snapshot.GetHistogramTotal(Histogram::kPathEdges), 3);
+  int path_edges = static_cast<int>(Histogram::kPathEdges);
+  ASSERT_EQ(snapshot.histograms[path_edges][0], 1);
+  ASSERT_EQ(snapshot.histograms[path_edges][3], 2);
+
+  metrics::Reset();
+  snapshot = metrics::Collect();
+  ASSERT_EQ(snapshot.GetCounter(Counter::kDijkstraRuns), 0);
+  ASSERT_EQ(snapshot.GetHistogramTotal(Histogram::kPathEdges), 0);
+}
+
+TEST(Metrics, FinishedThreads) {
+  metrics::Reset();
+  std::thread first([] { metrics::Add(Counter::kSettledVertices, 10); });
+  std::thread second([] { metrics::Add(Counter::kSettledVertices, 20); });
+  first.join();
+  second.join();
+  metrics::Add(Counter::kSettledVertices, 1);
+
+  ASSERT_EQ(metrics::Collect().GetCounter(Counter::kSettledVertices), 31);
+  metrics::Reset();
+  ASSERT_EQ(metrics::Collect().GetCounter(Counter::kSettledVertices), 0);
+}
+
+TEST(Metrics, Export) {
+  metrics::Reset();
+  metrics::Add(Counter::kHeapPushes, 4);
+  metrics::Record(Histogram::kTransportNs, 2);
+  metrics::Record(Histogram::kTransportNs, 3);
+  auto snapshot = metrics::Collect();
+
+  ASSERT_EQ(snapshot.ToJson(),
+            "{\"counters\": {\"breadth_first_search_runs\": 0, "
+            "\"dijkstra_runs\": 0, \"delta_stepping_runs\": 0, "
+            "\"settled_vertices\": 0, \"heap_pushes\": 4, "
+            "\"move_closest_vehicles_calls\": 0, "
+            "\"transport_fallbacks\": 0}, "
+            "\"histograms\": {\"transport_ns\": [0, 0, 2], "
+            "\"transport_with_returns_ns\": [], "
+            "\"move_closest_vehicles_ns\": [], \"path_edges\": []}}");
+  ASSERT_EQ(snapshot.ToText(),
+            "breadth_first_search_runs: 0\n"
+            "dijkstra_runs: 0\n"
+            "delta_stepping_runs: 0\n"
+            "settled_vertices: 0\n"
+            "heap_pushes: 4\n"
+            "move_closest_vehicles_calls: 0\n"
+            "transport_fallbacks: 0\n"
+            "transport_ns:\n"
+            "  [2, 4): 2\n"
+            "transport_with_returns_ns:\n"
+            "move_closest_vehicles_ns:\n"
+            "path_edges:\n");
+  metrics::Reset();
+}
+
+#ifdef BUNS_METRICS
+TEST(Metrics, TrafficManager) {
+  Graph graph({{{1, 1}}, {{0, 1}, {2, 1}}, {{1, 1}}});
+  TrafficManager traffic_manager(&graph, {4, 0, 0}, {0, 0, 2}, 2);
+
+  metrics::Reset();
+  traffic_manager.Transport(0, 1, 4);
+  auto snapshot = metrics::Collect();
+  ASSERT_EQ(snapshot.GetCounter(Counter::kTransportFallbacks), 1);
+  ASSERT_EQ(snapshot.GetCounter(Counter::kMoveClosestVehiclesCalls), 1);
+  ASSERT_GE(snapshot.GetCounter(Counter::kDijkstraRuns), 1);
+  ASSERT_EQ(snapshot.GetHistogramTotal(Histogram::kTransportNs), 1);
+  ASSERT_EQ(snapshot.GetHistogramTotal(Histogram::kPathEdges), 1);
+  metrics::Reset();
+}
+#endif
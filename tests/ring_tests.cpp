@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Graphs/Ring/ring.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// length of the path, std::nullopt if it's not a path of the graph or
+// doesn't end in 'to'
+std::optional<int> GetPathLength(const Ring& graph,
+                                 const std::vector<Ring::Edge>& path,
+                                 int from,
+                                 int to) {
+  int distance = 0;
+  for (const auto& edge : path) {
+    auto edges = graph.GetEdges(from);
+    if (std::find(edges.begin(), edges.end(), edge) == edges.end()) {
+      return std::nullopt;
+    }
+    distance += edge.length;
+    from = edge.to;
+  }
+  if (from != to) {
+    return std::nullopt;
+  }
+  return distance;
+}
+
+// ring with shuffled indices and random lengths
+std::vector<std::vector<Ring::Edge>> GenerateRing(int n, std::mt19937* gen) {
+  std::vector<int> permutation(n);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), *gen);
+  std::uniform_int_distribution<int> length(1, 100);
+  std::vector<std::vector<Ring::Edge>> list(n);
+  for (int i = 0; i < n; ++i) {
+    int from = permutation[i];
+    int to = permutation[(i + 1) % n];
+    int edge_length = length(*gen);
+    list[from].emplace_back(to, edge_length);
+    list[to].emplace_back(from, edge_length);
+  }
+  return list;
+}
+
+}  // namespace
+
+TEST(Ring, Constructors) {
+  {
+    Ring graph;
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Ring graph(1);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 1);
+    ASSERT_TRUE(graph.GetEdges(0).empty());
+  }
+  {
+    Ring graph(5);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 5);
+    ASSERT_EQ(graph.GetSize(), 5);
+    for (int from = 0; from < 5; ++from) {
+      ASSERT_EQ(graph.GetEdges(from).size(), 2);
+      ASSERT_EQ(graph.GetEdgeLength(from, (from + 1) % 5), 1);
+      ASSERT_EQ(graph.GetEdgeLength(from, (from + 4) % 5), 1);
+    }
+  }
+  {
+    std::vector<std::vector<Ring::Edge>> connections = {
+        {Ring::Edge(2, 1), Ring::Edge(1, 7)},
+        {Ring::Edge(2, 3), Ring::Edge(0, 7)},
+        {Ring::Edge(1, 3), Ring::Edge(0, 1)},
+    };
+
+    Ring graph1(connections);
+    Ring graph2(std::vector<int>{7, 3, 1});
+    ASSERT_EQ(graph1.GetEdgesCount(), 3);
+    for (int from = 0; from < 3; ++from) {
+      for (int to = 0; to < 3; ++to) {
+        ASSERT_EQ(graph1.GetEdgeLength(from, to),
+                  graph2.GetEdgeLength(from, to));
+        ASSERT_EQ(graph1.GetDistance(from, to), graph2.GetDistance(from, to));
+      }
+    }
+    ASSERT_EQ(graph1.GetDistance(0, 1), 4);
+  }
+  {
+    // two vertices with two edges between them
+    std::vector<std::vector<Ring::Edge>> connections = {
+        {Ring::Edge(1, 5), Ring::Edge(1, 2)},
+        {Ring::Edge(0, 5), Ring::Edge(0, 2)},
+    };
+
+    Ring graph(connections);
+    ASSERT_EQ(graph.GetEdgesCount(), 2);
+    ASSERT_EQ(graph.GetDistance(0, 1), 2);
+    ASSERT_EQ(graph.GetShortestPath(1, 0),
+              std::vector<Ring::Edge>({Ring::Edge(0, 2)}));
+  }
+}
+
+TEST(Ring, GetShortestPath) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    int size = std::uniform_int_distribution<int>(2, 60)(gen);
+    auto list = GenerateRing(size, &gen);
+    Ring graph(list);
+    Graph expected(list);
+
+    for (int from = 0; from < size; ++from) {
+      const auto& tree = algorithms::Dijkstra(expected, from);
+      auto paths = graph.GetShortestPaths(from);
+      for (int to = 0; to < size; ++to) {
+        auto path = graph.GetShortestPath(from, to);
+        ASSERT_EQ(GetPathLength(graph, path, from, to), tree.GetDistance(to));
+        ASSERT_EQ(graph.GetDistance(from, to), tree.GetDistance(to));
+        ASSERT_EQ(path, graph.GetAnyPath(from, to));
+        ASSERT_EQ(path, paths[to]);
+      }
+    }
+  }
+}
@@ -0,0 +1,194 @@
+#include <sstream>
+
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Trace/trace.h"
+#include "gtest/gtest.h"
+
+TEST(Trace, ReadWrite) {
+  Trace trace;
+  trace.vehicle_capacity = 14;
+  trace.operations = {
+      {TraceOperation::Type::kSetBunsAmounts, {1, 2, 3}},
+      {TraceOperation::Type::kSetVehicles, {}},
+      {TraceOperation::Type::kTransport, {0, 2, 1}},
+      {TraceOperation::Type::kTransportWithReturns, {2, 1, 3}},
+      {TraceOperation::Type::kMoveVehicles, {1, 0, 4}},
+      {TraceOperation::Type::kSetBunsAmount, {1, 5}},
+      {TraceOperation::Type::kSetVehicle, {2, 7}},
+  };
+
+  std::stringstream stream;
+  WriteTrace(stream, trace);
+  ASSERT_EQ(stream.str(),
+            "VehicleCapacity 14\n"
+            "SetBunsAmounts 3 1 2 3\n"
+            "SetVehicles 0\n"
+            "Transport 0 2 1\n"
+            "TransportWithReturns 2 1 3\n"
+            "MoveVehicles 1 0 4\n"
+            "SetBunsAmount 1 5\n"
+            "SetVehicle 2 7\n");
+  ASSERT_EQ(ReadTrace(stream), trace);
+
+  trace.vehicle_capacity = 5;
+  trace.vehicle_types = {{5, 1}, {20, 3}};
+  trace.operations = {{TraceOperation::Type::kSetFleet, {1, 0, 0, 2}}};
+  std::stringstream fleet_stream;
+  WriteTrace(fleet_stream, trace);
+  ASSERT_EQ(fleet_stream.str(),
+            "VehicleCapacity 5\n"
+            "VehicleTypes 2 5 1 20 3\n"
+            "SetFleet 4 1 0 0 2\n");
+  ASSERT_EQ(ReadTrace(fleet_stream), trace);
+}
+
+TEST(Trace, ReadMalformed) {
+  for (const auto& text : {"",
+                           "Transport 0 1 2",
+                           "VehicleCapacity 0",
+                           "VehicleCapacity 1\nTransport 0 1",
+                           "VehicleCapacity 1\nSetVehicles 2 1",
+                           "VehicleCapacity 1\nFly 0 1 2",
+                           "VehicleCapacity 1\nVehicleTypes 0",
+                           "VehicleCapacity 1\nVehicleTypes 1 5 0",
+                           "VehicleCapacity 1\nVehicleTypes 1 -5 1",
+                           "VehicleCapacity 1\nSetFleet 0\n"
+                           "VehicleTypes 1 1 1"}) {
+    std::stringstream stream(text);
+    ASSERT_EQ(ReadTrace(stream), std::nullopt);
+  }
+}
+
+TEST(Trace, ReadWriteGraph) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(4, 6)},
+      {Graph::Edge(2, 3), Graph::Edge(4, 1)},
+      {Graph::Edge(1, 3), Graph::Edge(3, 2)},
+      {Graph::Edge(2, 2), Graph::Edge(4, 7)},
+      {Graph::Edge(0, 6), Graph::Edge(1, 1), Graph::Edge(3, 7)}};
+  Graph graph(connections);
+
+  std::stringstream stream;
+  WriteGraph(stream, graph);
+  auto list = ReadGraph(stream);
+  ASSERT_NE(list, std::nullopt);
+  Graph read_graph(*list);
+  ASSERT_EQ(read_graph.GetSize(), graph.GetSize());
+  for (int from = 0; from < graph.GetSize(); ++from) {
+    for (int to = 0; to < graph.GetSize(); ++to) {
+      ASSERT_EQ(read_graph.GetEdgeLength(from, to),
+                graph.GetEdgeLength(from, to));
+    }
+  }
+
+  std::stringstream malformed("2 1\n0 2 1\n");
+  ASSERT_EQ(ReadGraph(malformed), std::nullopt);
+  std::stringstream negative("2 1\n0 1 -1\n");
+  ASSERT_EQ(ReadGraph(negative), std::nullopt);
+}
+
+TEST(Trace, RecordReplay) {
+  Graph graph(4);
+  TrafficManager traffic_manager(&graph, {10, 0, 5, 0}, {1, 0, 2, 0}, 4);
+  TraceRecorder recorder(&traffic_manager, 4);
+  std::vector<int> results;
+  results.push_back(recorder.Transport(0, 1, 8));
+  results.push_back(recorder.TransportWithReturns(2, 3, 5));
+  recorder.SetVehicle(3, 6);
+  results.push_back(recorder.MoveVehicles(3, 0, 2));
+  recorder.SetBunsAmount(1, 3);
+
+  std::stringstream stream;
+  WriteTrace(stream, recorder.GetTrace());
+  auto trace = ReadTrace(stream);
+  ASSERT_NE(trace, std::nullopt);
+
+  TrafficManager replayed =
+      CreateTraceManager<AbstractGraph>(&graph, *trace);
+  std::vector<int> replayed_results;
+  for (const auto& operation : trace->operations) {
+    int result = ApplyOperation(&replayed, operation);
+    if (operation.type == TraceOperation::Type::kTransport ||
+        operation.type == TraceOperation::Type::kTransportWithReturns ||
+        operation.type == TraceOperation::Type::kMoveVehicles) {
+      replayed_results.push_back(result);
+    }
+  }
+
+  ASSERT_EQ(replayed_results, results);
+  ASSERT_EQ(replayed.GetBunsAmounts(), traffic_manager.GetBunsAmounts());
+  ASSERT_EQ(replayed.GetVehicles(), traffic_manager.GetVehicles());
+  ASSERT_EQ(GetStateChecksum(replayed), GetStateChecksum(traffic_manager));
+}
+
+TEST(Trace, RecordReplayFleet) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(1, 2)},
+      {Graph::Edge(0, 2), Graph::Edge(2, 3)},
+      {Graph::Edge(1, 3)}};
+  Graph graph(connections);
+  // fast small vehicles and slow big ones
+  TrafficManager traffic_manager(&graph, {30, 0, 0}, {{5, 1}, {20, 3}},
+                                 {0, 1, 1, 0, 0, 1});
+  TraceRecorder recorder(&traffic_manager, 5);
+  std::vector<int> results;
+  results.push_back(recorder.Transport(0, 1, 25));
+  recorder.SetFleet({1, 1, 0, 0, 0, 0});
+  results.push_back(recorder.TransportWithReturns(0, 2, 5));
+  results.push_back(recorder.MoveVehicles(2, 0, 1));
+
+  std::stringstream stream;
+  WriteTrace(stream, recorder.GetTrace());
+  auto trace = ReadTrace(stream);
+  ASSERT_NE(trace, std::nullopt);
+  ASSERT_EQ(trace->vehicle_types, traffic_manager.GetVehicleTypes());
+
+  TrafficManager replayed =
+      CreateTraceManager<AbstractGraph>(&graph, *trace);
+  std::vector<int> replayed_results;
+  for (const auto& operation : trace->operations) {
+    ASSERT_TRUE(IsValidOperation(replayed, operation));
+    int result = ApplyOperation(&replayed, operation);
+    if (operation.type == TraceOperation::Type::kTransport ||
+        operation.type == TraceOperation::Type::kTransportWithReturns ||
+        operation.type == TraceOperation::Type::kMoveVehicles) {
+      replayed_results.push_back(result);
+    }
+  }
+
+  ASSERT_EQ(replayed_results, results);
+  ASSERT_EQ(replayed.GetBunsAmounts(), traffic_manager.GetBunsAmounts());
+  ASSERT_EQ(replayed.GetFleet(), traffic_manager.GetFleet());
+  ASSERT_EQ(GetStateChecksum(replayed), GetStateChecksum(traffic_manager));
+}
+
+TEST(Trace, IsValidOperation) {
+  Graph graph(2);
+  TrafficManager traffic_manager(&graph, {10, 0}, {1, 0}, 4);
+  using Type = TraceOperation::Type;
+  for (const auto& operation : std::vector<TraceOperation>{
+           {Type::kTransport, {0, 1, 10}},
+           {Type::kTransportWithReturns, {1, 0, 0}},
+           {Type::kMoveVehicles, {0, 1, 5}},
+           {Type::kSetBunsAmount, {1, 3}},
+           {Type::kSetVehicle, {0, 0}},
+           {Type::kSetBunsAmounts, {1, 2}},
+           {Type::kSetVehicles, {0, 0}},
+           {Type::kSetFleet, {0, 3}}}) {
+    ASSERT_TRUE(IsValidOperation(traffic_manager, operation));
+  }
+  for (const auto& operation : std::vector<TraceOperation>{
+           {Type::kTransport, {7, 0, 1}},
+           {Type::kTransport, {0, 1, 11}},
+           {Type::kTransport, {0, 1, -1}},
+           {Type::kTransportWithReturns, {0, 2, 1}},
+           {Type::kMoveVehicles, {0, -1, 1}},
+           {Type::kSetBunsAmount, {2, 3}},
+           {Type::kSetVehicle, {0, -1}},
+           {Type::kSetBunsAmounts, {1, 2, 3}},
+           {Type::kSetVehicles, {1}},
+           {Type::kSetFleet, {0, 3, 1}},
+           {Type::kSetFleet, {0, -3}}}) {
+    ASSERT_FALSE(IsValidOperation(traffic_manager, operation));
+  }
+}
@@ -1,6 +1,19 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <optional>
+#include <random>
+#include <stop_token>
+#include <thread>
+
+#include "../src/Executor/executor.h"
+#include "../src/Graphs/Chain/chain.h"
+#include "../src/Graphs/Composite/composite.h"
 #include "../src/Graphs/Graph/graph.h"
+#include "../src/Graphs/Grid/grid.h"
+#include "../src/Graphs/Ring/ring.h"
+#include "../src/Graphs/Tree/tree.h"
+#include "../src/TrafficManager/async_traffic_manager.h"
 #include "../src/TrafficManager/traffic_manager.h"
 
 class TrafficManagerTester {
@@ -606,3 +619,567 @@ TEST(TrafficManager, TransportWithReturns) {
     ASSERT_EQ(traffic_manager.GetTotalVehicles(), 4);
   }
 }
+
+TEST(TrafficManager, DispatchVehicles) {
+  Chain chain(std::vector<int>{1, 2, 3, 4});
+  {
+    TrafficManager traffic_manager(&chain, {0, 0, 0, 0, 0}, {3, 0, 0, 0, 1}, 1);
+    ASSERT_EQ(traffic_manager.DispatchVehicles({0, 2, 0, 0, 2}), 10);
+    ASSERT_EQ(traffic_manager.GetVehicles(),
+              std::vector<int>({0, 2, 0, 0, 2}));
+    ASSERT_EQ(traffic_manager.GetTotalVehicles(), 4);
+  }
+  {
+    // vehicles from 3 go to 4, so 0 gets ones from 1 instead of waiting
+    // for them from 3
+    TrafficManager traffic_manager(&chain, {0, 0, 0, 0, 0}, {0, 1, 0, 1, 0}, 1);
+    ASSERT_EQ(traffic_manager.DispatchVehicles({1, 0, 0, 0, 1}), 4);
+    ASSERT_EQ(traffic_manager.GetVehicles(),
+              std::vector<int>({1, 0, 0, 0, 1}));
+  }
+  {
+    // not enough vehicles
+    TrafficManager traffic_manager(&chain, {0, 0, 0, 0, 0}, {0, 0, 1, 0, 0}, 1);
+    ASSERT_EQ(traffic_manager.DispatchVehicles({2, 0, 0, 0, 0}), 3);
+    ASSERT_EQ(traffic_manager.GetVehicles(),
+              std::vector<int>({1, 0, 0, 0, 0}));
+    ASSERT_EQ(traffic_manager.DispatchVehicles({0, 0, 0, 0, 0}), 0);
+  }
+  {
+    // vehicles of the other component can't come
+    Graph graph({{{1, 1}}, {{0, 1}}, {{3, 1}}, {{2, 1}}});
+    TrafficManager traffic_manager(&graph, {10, 0, 0, 0}, {0, 0, 5, 0}, 5);
+    ASSERT_EQ(traffic_manager.DispatchVehicles({2, 0, 0, 0}), 0);
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({0, 0, 5, 0}));
+    // some deficits are covered, others are unreachable
+    ASSERT_EQ(traffic_manager.DispatchVehicles({1, 1, 1, 1}), 1);
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({0, 0, 4, 1}));
+    ASSERT_EQ(traffic_manager.TransportBatch({{0, 1, 5}}),
+              std::vector<int>({0}));
+    ASSERT_EQ(traffic_manager.Redistribute({0, 10, 0, 0}).size(), 1);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({0, 10, 0, 0}));
+  }
+}
+
+TEST(TrafficManager, TransportBatch) {
+  Chain chain(std::vector<int>{1, 2, 3, 4});
+  TrafficManager traffic_manager(&chain, {10, 0, 5, 0, 0}, {0, 0, 0, 1, 2}, 5);
+  ASSERT_EQ(traffic_manager.TransportBatch({{0, 1, 10}, {2, 4, 5}}),
+            std::vector<int>({11, 10}));
+  ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({0, 2, 0, 0, 1}));
+  ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+            std::vector<int>({0, 10, 0, 0, 5}));
+  ASSERT_EQ(traffic_manager.GetTotalBunsAmount(), 15);
+  ASSERT_EQ(traffic_manager.GetTotalVehicles(), 3);
+
+  ASSERT_TRUE(traffic_manager.TransportBatch({}).empty());
+}
+
+TEST(TrafficManager, Redistribute) {
+  Chain chain(std::vector<int>{10, 1, 2});
+  TrafficManager traffic_manager(&chain, {0, 5, 1, 5}, {0, 1, 0, 1}, 5);
+  auto orders = traffic_manager.Redistribute({5, 0, 6, 0});
+  ASSERT_EQ(orders.size(), 2);
+  ASSERT_EQ(orders[0].from, 1);
+  ASSERT_EQ(orders[0].to, 0);
+  ASSERT_EQ(orders[0].buns_amount, 5);
+  ASSERT_EQ(orders[1].from, 3);
+  ASSERT_EQ(orders[1].to, 2);
+  ASSERT_EQ(orders[1].buns_amount, 5);
+  ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({5, 0, 6, 0}));
+  ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({1, 0, 1, 0}));
+
+  ASSERT_TRUE(traffic_manager.Redistribute({5, 0, 6, 0}).empty());
+
+  {
+    // buns of 2 can't reach 1
+    Graph graph(std::vector<std::vector<Graph::Edge>>{
+        {{1, 1}}, {{0, 1}}, {}});
+    TrafficManager traffic_manager(&graph, {4, 0, 3}, {1, 0, 1}, 5);
+    auto orders = traffic_manager.Redistribute({2, 5, 0});
+    ASSERT_EQ(orders.size(), 1);
+    ASSERT_EQ(orders[0].from, 0);
+    ASSERT_EQ(orders[0].to, 1);
+    ASSERT_EQ(orders[0].buns_amount, 2);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({2, 2, 3}));
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({0, 1, 1}));
+  }
+}
+
+TEST(TrafficManager, TransportWithTours) {
+  Chain chain(std::vector<int>{1, 1, 1, 1});
+  {
+    // one vehicle takes 4 buns to 2, another one visits 2, 3 and 4
+    TrafficManager traffic_manager(&chain, {10, 0, 0, 0, 0}, {0, 0, 0, 0, 2},
+                                   4);
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{2, 5}, {4, 2}, {3, 1}}),
+              8);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({2, 0, 5, 1, 2}));
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({0, 0, 1, 0, 1}));
+    ASSERT_EQ(traffic_manager.GetTotalBunsAmount(), 10);
+    ASSERT_EQ(traffic_manager.GetTotalVehicles(), 2);
+  }
+  {
+    TrafficManager traffic_manager(&chain, {0, 0, 4, 0, 0}, {0, 0, 2, 0, 0}, 2);
+    ASSERT_EQ(traffic_manager.TransportWithTours(2, {{0, 1}, {1, 1}, {4, 1}}),
+              2);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({1, 1, 1, 0, 1}));
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({1, 0, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.TransportWithTours(2, {}), 0);
+  }
+  {
+    // the same tours with searches on a separate pool
+    executor::ThreadPool thread_pool(2);
+    TrafficManager traffic_manager(&chain, {10, 0, 0, 0, 0}, {0, 0, 0, 0, 2},
+                                   4);
+    traffic_manager.SetExecutor(&thread_pool);
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{2, 5}, {4, 2}, {3, 1}}),
+              8);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({2, 0, 5, 1, 2}));
+  }
+  {
+    // town 2 is unreachable, its delivery isn't done
+    Graph graph({{{1, 3}}, {{0, 3}}, {}});
+    TrafficManager traffic_manager(&graph, {5, 0, 0}, {3, 0, 0}, 2);
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{1, 1}}), 3);
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{2, 3}, {1, 1}}),
+              algorithms::kInf);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({3, 2, 0}));
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 2, 0}));
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{2, 2}}),
+              algorithms::kInf);
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({3, 2, 0}));
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 2, 0}));
+  }
+}
+
+TEST(TrafficManager, Fleet) {
+  Chain chain(std::vector<int>{1, 1, 1, 1});
+  // vans are fast, trucks are large
+  std::vector<TrafficManager::VehicleType> types = {{5, 1}, {20, 2}};
+  {
+    TrafficManager traffic_manager(&chain, {40, 0, 0, 0, 0}, types,
+                                   {3, 1, 0, 0, 0, 0, 0, 0, 0, 0});
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({4, 0, 0, 0, 0}));
+    ASSERT_EQ(traffic_manager.GetTotalVehicles(), 4);
+
+    // vans are enough and arrive first
+    ASSERT_EQ(traffic_manager.Transport(0, 4, 12), 4);
+    ASSERT_EQ(traffic_manager.GetFleet(),
+              std::vector<int>({0, 1, 0, 0, 0, 0, 0, 0, 3, 0}));
+    ASSERT_EQ(traffic_manager.GetVehicles(), std::vector<int>({1, 0, 0, 0, 3}));
+
+    // only the truck can carry them
+    ASSERT_EQ(traffic_manager.Transport(0, 4, 18), 8);
+    ASSERT_EQ(traffic_manager.GetVehicle(4, 0), 3);
+    ASSERT_EQ(traffic_manager.GetVehicle(4, 1), 1);
+  }
+  {
+    // the closest truck is enough
+    TrafficManager traffic_manager(&chain, {10, 0, 0, 0, 0}, types,
+                                   {0, 0, 0, 1, 2, 0, 0, 0, 0, 0});
+    ASSERT_EQ(traffic_manager.Transport(0, 4, 10), 10);
+    ASSERT_EQ(traffic_manager.GetFleet(),
+              std::vector<int>({0, 0, 0, 0, 2, 0, 0, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({0, 0, 0, 0, 10}));
+
+    traffic_manager.SetVehicle(4, 2);
+    ASSERT_EQ(traffic_manager.GetVehicle(4, 0), 2);
+    ASSERT_EQ(traffic_manager.GetVehicle(4, 1), 0);
+    ASSERT_EQ(traffic_manager.GetTotalVehicles(), 4);
+  }
+  {
+    // the van makes three trips before the truck comes from 2
+    Chain short_chain(std::vector<int>{1, 1});
+    TrafficManager traffic_manager(&short_chain, {40, 0, 0}, types,
+                                   {1, 0, 0, 0, 0, 1});
+    ASSERT_EQ(traffic_manager.TransportWithReturns(0, 1, 40), 7);
+    ASSERT_EQ(traffic_manager.GetFleet(),
+              std::vector<int>({0, 0, 1, 1, 0, 0}));
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(),
+              std::vector<int>({0, 40, 0}));
+  }
+  {
+    // vehicles of zero capacity don't carry buns
+    Chain short_chain(std::vector<int>{1});
+    std::vector<TrafficManager::VehicleType> empty_types = {{0, 1}, {5, 1}};
+    TrafficManager traffic_manager(&short_chain, {20, 0}, empty_types,
+                                   {1, 1, 0, 0});
+    ASSERT_EQ(traffic_manager.Transport(0, 1, 10), 1);
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.TransportWithReturns(1, 0, 10), 3);
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 1, 0, 0}));
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({20, 0}));
+    ASSERT_EQ(traffic_manager.TransportBatch({{0, 1, 5}}),
+              std::vector<int>({1}));
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.TransportWithTours(0, {{1, 5}}), 2);
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({10, 10}));
+
+    // the vehicle of zero capacity stays, the one from 1 carries buns
+    ASSERT_EQ(traffic_manager.TransportBatch({{0, 1, 5}}),
+              std::vector<int>({2}));
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 0, 0, 1}));
+    ASSERT_EQ(traffic_manager.DispatchVehicles({1, 0}), 1);
+    ASSERT_EQ(traffic_manager.GetFleet(), std::vector<int>({1, 1, 0, 0}));
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({5, 15}));
+  }
+}
+
+TEST(TrafficManager, LargeTotals) {
+  Graph graph(2);
+  TrafficManager traffic_manager(&graph, {2'000'000'000, 2'000'000'000},
+                                 {2'000'000'000, 2'000'000'000}, 1);
+  ASSERT_EQ(traffic_manager.GetTotalBunsAmount(), 4'000'000'000);
+  ASSERT_EQ(traffic_manager.GetTotalVehicles(), 4'000'000'000);
+  traffic_manager.SetBunsAmount(0, 0);
+  ASSERT_EQ(traffic_manager.GetTotalBunsAmount(), 2'000'000'000);
+}
+
+TEST(TrafficManager, LongDistances) {
+  const int kLength = 2'000'000'000;
+  Graph graph({{{1, kLength}},
+               {{0, kLength}, {2, kLength}},
+               {{1, kLength}}});
+  graph.SetDistanceWidth(Graph::DistanceWidth::k64Bit);
+  BasicTrafficManager<Graph> traffic_manager(&graph, {2, 0, 0}, {2, 0, 0}, 1);
+
+  // 2 * kLength doesn't fit int, so the time saturates
+  ASSERT_EQ(traffic_manager.MoveVehicles(0, 1, 1), kLength);
+  ASSERT_EQ(traffic_manager.Transport(0, 2, 1), algorithms::kInf);
+  ASSERT_EQ(traffic_manager.GetBunsAmounts(), std::vector<int>({1, 0, 1}));
+
+  // distances fit int, but times of slow vehicles don't
+  Chain chain(std::vector<int>{1'000'000, 1'000'000});
+  std::vector<TrafficManager::VehicleType> slow_types = {{5, 10'000}};
+  {
+    TrafficManager slow_manager(&chain, {10, 0, 0}, slow_types, {0, 0, 2});
+    ASSERT_EQ(slow_manager.Transport(0, 1, 10), algorithms::kInf);
+    ASSERT_EQ(slow_manager.GetFleet(), std::vector<int>({0, 2, 0}));
+  }
+  {
+    TrafficManager slow_manager(&chain, {10, 0, 0}, slow_types, {0, 0, 1});
+    ASSERT_EQ(slow_manager.DispatchVehicles({1, 0, 0}), algorithms::kInf);
+    ASSERT_EQ(slow_manager.GetFleet(), std::vector<int>({1, 0, 0}));
+  }
+  {
+    TrafficManager slow_manager(&chain, {10, 0, 0}, slow_types, {1, 0, 1});
+    ASSERT_EQ(slow_manager.TransportWithReturns(0, 1, 10), algorithms::kInf);
+    ASSERT_EQ(slow_manager.GetBunsAmounts(), std::vector<int>({0, 10, 0}));
+  }
+}
+
+// requests stop of '*stop_source', when it's searched
+class StoppingGraph : public AbstractGraph {
+ public:
+  StoppingGraph(const Graph* graph, std::stop_source* stop_source) :
+      AbstractGraph(graph->GetSize()), graph_(graph),
+      stop_source_(stop_source) {}
+
+  std::vector<Edge> GetEdges(int from) const override {
+    stop_source_->request_stop();
+    return graph_->GetEdges(from);
+  }
+  int GetEdgesCount() const override {
+    return graph_->GetEdgesCount();
+  }
+  std::vector<Edge> GetAnyPath(int from, int to) const override {
+    return graph_->GetAnyPath(from, to);
+  }
+  std::vector<Edge> GetShortestPath(int from, int to) const override {
+    stop_source_->request_stop();
+    return graph_->GetShortestPath(from, to);
+  }
+  std::vector<std::vector<Edge>> GetShortestPaths(int from) const override {
+    return graph_->GetShortestPaths(from);
+  }
+
+ private:
+  const Graph* graph_;
+  std::stop_source* stop_source_;
+};
+
+TEST(TrafficManager, Async) {
+  std::vector<std::vector<Graph::Edge>> connections = {
+      {Graph::Edge(4, 6)},
+      {Graph::Edge(2, 3), Graph::Edge(4, 1)},
+      {Graph::Edge(1, 3), Graph::Edge(3, 2)},
+      {Graph::Edge(2, 2), Graph::Edge(4, 7)},
+      {Graph::Edge(0, 6), Graph::Edge(1, 1), Graph::Edge(3, 7)}};
+  Graph graph(connections);
+  std::vector<int> buns_amounts(5, 1000);
+  std::vector<int> vehicles = {2, 0, 1, 3, 0};
+
+  TrafficManager expected(&graph, buns_amounts, vehicles, 3);
+  TrafficManager traffic_manager(&graph, buns_amounts, vehicles, 3);
+  executor::ThreadPool thread_pool(2);
+  AsyncTrafficManager async(&traffic_manager, &thread_pool);
+
+  // results are the same as of synchronous calls in the same order
+  for (int i = 0; i < 30; ++i) {
+    int from = i % 5;
+    int to = (from + i % 4 + 1) % 5;
+    int amount = i % 7 + 1;
+    switch (i % 3) {
+      case 0:
+        ASSERT_EQ(executor::SyncWait(async.Transport(from, to, amount)),
+                  expected.Transport(from, to, amount));
+        break;
+      case 1:
+        ASSERT_EQ(executor::SyncWait(
+                      async.TransportWithReturns(from, to, amount)),
+                  expected.TransportWithReturns(from, to, amount));
+        break;
+      case 2:
+        ASSERT_EQ(executor::SyncWait(async.MoveVehicles(from, to, 1)),
+                  expected.MoveVehicles(from, to, 1));
+        break;
+    }
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), expected.GetBunsAmounts());
+    ASSERT_EQ(traffic_manager.GetVehicles(), expected.GetVehicles());
+    ASSERT_EQ(executor::SyncWait(async.GetShortestPath(from, to)),
+              graph.GetShortestPath(from, to));
+  }
+
+  // withdrawn orders change nothing
+  std::stop_source stop_source;
+  stop_source.request_stop();
+  ASSERT_EQ(executor::SyncWait(
+                async.Transport(0, 3, 10, stop_source.get_token())),
+            std::nullopt);
+  ASSERT_EQ(executor::SyncWait(
+                async.GetShortestPath(0, 3, stop_source.get_token())),
+            std::nullopt);
+  ASSERT_EQ(traffic_manager.GetBunsAmounts(), expected.GetBunsAmounts());
+  ASSERT_EQ(traffic_manager.GetVehicles(), expected.GetVehicles());
+
+  {
+    // stop is requested by the search for vehicles, changes are undone
+    std::stop_source searching_stop_source;
+    StoppingGraph stopping_graph(&graph, &searching_stop_source);
+    TrafficManager stopped(&stopping_graph, buns_amounts, {0, 0, 0, 5, 0}, 3);
+    AsyncTrafficManager stopped_async(&stopped, &thread_pool);
+    ASSERT_EQ(executor::SyncWait(stopped_async.Transport(
+                  0, 1, 10, searching_stop_source.get_token())),
+              std::nullopt);
+    ASSERT_EQ(stopped.GetBunsAmounts(), buns_amounts);
+    ASSERT_EQ(stopped.GetVehicles(), std::vector<int>({0, 0, 0, 5, 0}));
+    searching_stop_source = std::stop_source();
+    ASSERT_EQ(executor::SyncWait(stopped_async.GetShortestPath(
+                  0, 3, searching_stop_source.get_token())),
+              std::nullopt);
+    // the same operation without stop is completed
+    TrafficManager reference(&graph, buns_amounts, {0, 0, 0, 5, 0}, 3);
+    ASSERT_EQ(executor::SyncWait(stopped_async.Transport(0, 1, 10)),
+              reference.Transport(0, 1, 10));
+    ASSERT_EQ(stopped.GetBunsAmounts(), reference.GetBunsAmounts());
+    ASSERT_EQ(stopped.GetVehicles(), reference.GetVehicles());
+  }
+
+  // orders are applied in order, in which they are awaited
+  std::vector<std::optional<int>> results(10);
+  std::atomic<int> finished_count = 0;
+  for (int i = 0; i < 10; ++i) {
+    executor::Start<std::optional<int>>(
+        async.Transport(i % 5, 4 - i % 5, 5),
+        [&results, &finished_count, i](std::optional<int> result) {
+          results[i] = result;
+          ++finished_count;
+        });
+  }
+  while (finished_count < 10) {
+    std::this_thread::yield();
+  }
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(results[i], expected.Transport(i % 5, 4 - i % 5, 5));
+  }
+  ASSERT_EQ(traffic_manager.GetBunsAmounts(), expected.GetBunsAmounts());
+  ASSERT_EQ(traffic_manager.GetVehicles(), expected.GetVehicles());
+}
+
+// Compares random operations on a manager over 'graph', configured by
+// 'setup', with the same operations on a manager over 'reference_graph',
+// which has the same towns, then lets 'finish' compare them further.
+// Vehicles are in few towns, so searches are usually pruned early.
+template<typename ManagerType, typename GraphType,
+         typename Setup = void (*)(ManagerType*),
+         typename Finish = void (*)(ManagerType*, TrafficManager*)>
+void ExpectSameAsGraphManager(
+    const GraphType& graph, const Graph& reference_graph,
+    Setup setup = [](ManagerType*) {},
+    Finish finish = [](ManagerType*, TrafficManager*) {}) {
+  std::mt19937 gen(20220314);
+  const int kSize = graph.GetSize();
+  ASSERT_EQ(reference_graph.GetSize(), kSize);
+  std::uniform_int_distribution<int> town(0, kSize - 1);
+  std::vector<int> vehicles(kSize, 0);
+  for (int i = 0; i < 10; ++i) {
+    vehicles[town(gen)] += 3;
+  }
+  std::vector<int> buns_amounts(kSize, 100);
+  TrafficManager expected(&reference_graph, buns_amounts, vehicles, 5);
+  ManagerType traffic_manager(&graph, buns_amounts, vehicles, 5);
+  setup(&traffic_manager);
+  for (int i = 0; i < 50; ++i) {
+    int from = town(gen);
+    int to = town(gen);
+    if (from == to) {
+      continue;
+    }
+    ASSERT_EQ(traffic_manager.Transport(from, to, 12),
+              expected.Transport(from, to, 12));
+    ASSERT_EQ(traffic_manager.TransportWithReturns(to, from, 7),
+              expected.TransportWithReturns(to, from, 7));
+    ASSERT_EQ(traffic_manager.MoveVehicles(to, from, 2),
+              expected.MoveVehicles(to, from, 2));
+    ASSERT_EQ(traffic_manager.GetVehicles(), expected.GetVehicles());
+    ASSERT_EQ(traffic_manager.GetBunsAmounts(), expected.GetBunsAmounts());
+  }
+  finish(&traffic_manager, &expected);
+}
+
+TEST(TrafficManager, Landmarks) {
+  std::mt19937 gen(20220314);
+  const int kSize = 200;
+  std::vector<std::vector<Graph::Edge>> connections(kSize);
+  std::uniform_int_distribution<int> town(0, kSize - 1);
+  std::uniform_int_distribution<int> length(1, 1000);
+  for (int from = 1; from < kSize; ++from) {
+    // connected, with random shortcuts
+    int to = std::uniform_int_distribution<int>(0, from - 1)(gen);
+    for (int edge_to : {to, town(gen)}) {
+      int edge_length = length(gen);
+      connections[from].emplace_back(edge_to, edge_length);
+      connections[edge_to].emplace_back(from, edge_length);
+    }
+  }
+  Graph graph(connections);
+  auto landmarks = algorithms::Landmarks::Build(graph, 4);
+
+  ExpectSameAsGraphManager<TrafficManager>(
+      graph, graph,
+      [&landmarks](TrafficManager* traffic_manager) {
+        traffic_manager->SetLandmarks(&landmarks);
+      },
+      [](TrafficManager* traffic_manager, TrafficManager* expected) {
+        traffic_manager->SetLandmarks(nullptr);
+        ASSERT_EQ(traffic_manager->Transport(0, 1, 12),
+                  expected->Transport(0, 1, 12));
+      });
+}
+
+TEST(TrafficManager, Tree) {
+  std::mt19937 gen(20220314);
+  const int kSize = 200;
+  std::vector<std::vector<Graph::Edge>> connections(kSize);
+  std::uniform_int_distribution<int> length(1, 1000);
+  for (int from = 1; from < kSize; ++from) {
+    int to = std::uniform_int_distribution<int>(0, from - 1)(gen);
+    int edge_length = length(gen);
+    connections[from].emplace_back(to, edge_length);
+    connections[to].emplace_back(from, edge_length);
+  }
+  Graph graph(connections);
+  Tree tree(connections);
+
+  ExpectSameAsGraphManager<BasicTrafficManager<Tree>>(tree, graph);
+  ExpectSameAsGraphManager<TrafficManager>(
+      tree, graph, [](TrafficManager*) {},
+      [](TrafficManager* traffic_manager, TrafficManager* expected) {
+        traffic_manager->SetVehicle(0, 5);
+        expected->SetVehicle(0, 5);
+        ASSERT_EQ(traffic_manager->Transport(1, 2, 30),
+                  expected->Transport(1, 2, 30));
+        ASSERT_EQ(traffic_manager->GetVehicles(), expected->GetVehicles());
+      });
+}
+
+TEST(TrafficManager, Ring) {
+  std::mt19937 gen(20220314);
+  const int kSize = 100;
+  std::vector<int> lengths(kSize);
+  std::uniform_int_distribution<int> length(1, 1000);
+  for (int& edge_length : lengths) {
+    edge_length = length(gen);
+  }
+  Ring ring(lengths);
+  std::vector<std::vector<Graph::Edge>> connections(kSize);
+  for (int from = 0; from < kSize; ++from) {
+    connections[from] = ring.GetEdges(from);
+  }
+  Graph graph(connections);
+
+  ExpectSameAsGraphManager<BasicTrafficManager<Ring>>(ring, graph);
+}
+
+TEST(TrafficManager, Grid) {
+  std::mt19937 gen(20220314);
+  std::uniform_int_distribution<int> length(1, 1000);
+  std::vector<int> row_lengths(8);
+  std::vector<int> column_lengths(12);
+  for (int& row_length : row_lengths) {
+    row_length = length(gen);
+  }
+  for (int& column_length : column_lengths) {
+    column_length = length(gen);
+  }
+  for (const Grid& grid : {Grid(8, 12, 7),
+                           Grid(row_lengths, column_lengths)}) {
+    std::vector<std::vector<Graph::Edge>> connections(grid.GetSize());
+    for (int from = 0; from < grid.GetSize(); ++from) {
+      connections[from] = grid.GetEdges(from);
+    }
+    Graph graph(connections);
+
+    ExpectSameAsGraphManager<BasicTrafficManager<Grid>>(grid, graph);
+  }
+}
+
+TEST(TrafficManager, Composite) {
+  Composite composite(60);
+  std::vector<std::vector<Graph::Edge>> connections(composite.GetSize());
+  for (int from = 0; from < composite.GetSize(); ++from) {
+    connections[from] = composite.GetEdges(from);
+  }
+  Graph graph(connections);
+
+  ExpectSameAsGraphManager<BasicTrafficManager<Composite>>(composite, graph);
+}
+
+TEST(TrafficManager, HubLabels) {
+  std::mt19937 gen(20220314);
+  const int kSize = 200;
+  std::vector<std::vector<Graph::Edge>> connections(kSize);
+  std::uniform_int_distribution<int> town(0, kSize - 1);
+  std::uniform_int_distribution<int> length(1, 1000);
+  // the last town is unreachable
+  for (int from = 1; from + 1 < kSize; ++from) {
+    int to = std::uniform_int_distribution<int>(0, from - 1)(gen);
+    for (int edge_to : {to, town(gen) % (kSize - 1)}) {
+      int edge_length = length(gen);
+      connections[from].emplace_back(edge_to, edge_length);
+      connections[edge_to].emplace_back(from, edge_length);
+    }
+  }
+  Graph graph(connections);
+  auto hub_labels = algorithms::HubLabels::Build(graph);
+
+  ExpectSameAsGraphManager<TrafficManager>(
+      graph, graph,
+      [&hub_labels](TrafficManager* traffic_manager) {
+        traffic_manager->SetHubLabels(&hub_labels);
+      },
+      [](TrafficManager* traffic_manager, TrafficManager* expected) {
+        std::vector<TrafficManager::Delivery> deliveries = {
+            {1, 3}, {2, 12}, {kSize - 1, 2}};
+        ASSERT_EQ(traffic_manager->TransportWithTours(0, deliveries),
+                  expected->TransportWithTours(0, deliveries));
+        ASSERT_EQ(traffic_manager->GetVehicles(), expected->GetVehicles());
+      });
+}
@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../src/Graphs/Algorithms/algorithms.h"
+#include "../src/Graphs/Graph/graph.h"
+#include "../src/Graphs/Tree/tree.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+// random forest of 'trees_count' trees with shuffled indices
+std::vector<std::vector<Tree::Edge>> GenerateForest(int n,
+                                                    int trees_count,
+                                                    std::mt19937* gen) {
+  std::vector<int> permutation(n);
+  for (int i = 0; i < n; ++i) {
+    permutation[i] = i;
+  }
+  std::shuffle(permutation.begin(), permutation.end(), *gen);
+  std::uniform_int_distribution<int> length(1, 100);
+  std::vector<std::vector<Tree::Edge>> list(n);
+  for (int i = trees_count; i < n; ++i) {
+    int parent = std::uniform_int_distribution<int>(0, i - 1)(*gen);
+    int edge_length = length(*gen);
+    list[permutation[i]].emplace_back(permutation[parent], edge_length);
+    list[permutation[parent]].emplace_back(permutation[i], edge_length);
+  }
+  return list;
+}
+
+}  // namespace
+
+TEST(Tree, Constructors) {
+  {
+    Tree graph;
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Tree graph(0);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 0);
+    ASSERT_EQ(graph.GetSize(), 0);
+  }
+  {
+    Tree graph(7);
+
+    ASSERT_EQ(graph.GetEdgesCount(), 6);
+    ASSERT_EQ(graph.GetSize(), 7);
+    for (int vertex = 1; vertex < 7; ++vertex) {
+      ASSERT_EQ(graph.GetEdgeLength(vertex, (vertex - 1) / 2), 1);
+      ASSERT_EQ(graph.GetEdges(vertex).size(), vertex < 3 ? 3 : 1);
+    }
+    ASSERT_EQ(graph.GetEdges(0).size(), 2);
+  }
+  {
+    std::vector<std::vector<Tree::Edge>> connections = {
+        {Tree::Edge(1, 1), Tree::Edge(2, 2)},
+        {Tree::Edge(0, 1)},
+        {Tree::Edge(0, 2)},
+        {},
+    };
+
+    Tree graph(connections);
+    ASSERT_EQ(graph.GetSize(), 4);
+    ASSERT_EQ(graph.GetEdgesCount(), 2);
+    ASSERT_EQ(graph.GetEdgeLength(0, 2), 2);
+    ASSERT_EQ(graph.GetEdgeLength(2, 0), 2);
+    ASSERT_TRUE(graph.GetEdges(3).empty());
+    ASSERT_EQ(graph.GetRoot(2), 0);
+    ASSERT_EQ(graph.GetRoot(3), 3);
+  }
+}
+
+TEST(Tree, GetEdges) {
+  std::mt19937 gen(20220314);
+  auto list = GenerateForest(100, 3, &gen);
+  Tree graph(list);
+  ASSERT_EQ(graph.GetEdgesCount(), 97);
+  for (int from = 0; from < 100; ++from) {
+    auto edges = graph.GetEdges(from);
+    auto expected = list[from];
+    auto by_to = [](const Tree::Edge& lhs, const Tree::Edge& rhs) {
+      return lhs.to < rhs.to;
+    };
+    std::sort(edges.begin(), edges.end(), by_to);
+    std::sort(expected.begin(), expected.end(), by_to);
+    ASSERT_EQ(edges, expected);
+  }
+}
+
+TEST(Tree, GetShortestPath) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    const int kSize = 100;
+    auto list = GenerateForest(kSize, test % 3 + 1, &gen);
+    Tree graph(list);
+    Graph expected(list);
+
+    for (int from = 0; from < kSize; ++from) {
+      const auto& tree = algorithms::Dijkstra(expected, from);
+      auto paths = graph.GetShortestPaths(from);
+      for (int to = 0; to < kSize; ++to) {
+        ASSERT_EQ(graph.GetDistance(from, to), tree.GetDistance(to));
+        auto path = graph.GetShortestPath(from, to);
+        ASSERT_EQ(path, expected.GetShortestPath(from, to));
+        ASSERT_EQ(path, graph.GetAnyPath(from, to));
+        ASSERT_EQ(path, paths[to]);
+      }
+    }
+  }
+}
+
+TEST(Tree, Subtrees) {
+  Tree graph(7);
+  // preorder ranges of subtrees are nested as the tree
+  for (int vertex = 0; vertex < 7; ++vertex) {
+    int begin = graph.GetPreorderIndex(vertex);
+    int end = graph.GetSubtreeEnd(vertex);
+    ASSERT_EQ(end - begin, vertex == 0 ? 7 : (vertex < 3 ? 3 : 1));
+    if (vertex > 0) {
+      int parent = (vertex - 1) / 2;
+      ASSERT_LT(graph.GetPreorderIndex(parent), begin);
+      ASSERT_LE(end, graph.GetSubtreeEnd(parent));
+    }
+  }
+}
+
+TEST(Tree, VisitClosestVertices) {
+  std::mt19937 gen(20220314);
+  for (int test = 0; test < 10; ++test) {
+    const int kSize = 100;
+    auto list = GenerateForest(kSize, test % 3 + 1, &gen);
+    Tree graph(list);
+
+    std::vector<int> targets(kSize, 0);
+    std::vector<int> target_positions(kSize, 0);
+    for (int i = 0; i < 5; ++i) {
+      int target = std::uniform_int_distribution<int>(0, kSize - 1)(gen);
+      targets[target] = 1;
+      target_positions[graph.GetPreorderIndex(target)] = 1;
+    }
+    auto count_targets = [&](int begin, int end) {
+      int count = 0;
+      for (int i = begin; i < end; ++i) {
+        count += target_positions[i];
+      }
+      return count;
+    };
+
+    for (int from = 0; from < kSize; ++from) {
+      std::vector<std::pair<int, int>> expected;
+      std::vector<std::pair<int, int>> expected_targets;
+      algorithms::VisitClosestVertices(graph, from, [&](int vertex,
+                                                        int distance) {
+        expected.emplace_back(vertex, distance);
+        if (targets[vertex] && vertex != from) {
+          expected_targets.emplace_back(vertex, distance);
+        }
+        return true;
+      });
+
+      std::vector<std::pair<int, int>> visited;
+      graph.VisitClosestVertices(
+          from,
+          [&](int vertex, int distance) {
+            visited.emplace_back(vertex, distance);
+            return true;
+          },
+          [](int, int) { return 1; });
+      ASSERT_EQ(visited, expected);
+
+      // only towns on paths to targets are visited
+      std::vector<std::pair<int, int>> visited_targets;
+      int visited_count = 0;
+      graph.VisitClosestVertices(
+          from,
+          [&](int vertex, int distance) {
+            ++visited_count;
+            if (targets[vertex] && vertex != from) {
+              visited_targets.emplace_back(vertex, distance);
+            }
+            return true;
+          },
+          count_targets);
+      ASSERT_EQ(visited_targets, expected_targets);
+      ASSERT_LE(visited_count, expected.size());
+    }
+  }
+}